@@ -0,0 +1,401 @@
+#include <xc.h>
+#include "bitbang.h"
+
+/* SFR of a compile-time pin: BB_REG(LAT, B, SET) -> LATBSET */
+#define BB_PASTE(prefix, port, suffix) prefix##port##suffix
+#define BB_REG(prefix, port, suffix) BB_PASTE(prefix, port, suffix)
+#define BB_MASK(bit) (1u << (bit))
+
+#define WS_HIGH()       (BB_REG(LAT, WS2812_PORT, SET) = BB_MASK(WS2812_BIT))
+#define WS_LOW()        (BB_REG(LAT, WS2812_PORT, CLR) = BB_MASK(WS2812_BIT))
+
+/* Open-drain lines: LAT stays LOW, TRIS CLR drives LOW, TRIS SET releases */
+#define OW_LOW()        (BB_REG(TRIS, ONEWIRE_PORT, CLR) = BB_MASK(ONEWIRE_BIT))
+#define OW_RELEASE()    (BB_REG(TRIS, ONEWIRE_PORT, SET) = BB_MASK(ONEWIRE_BIT))
+#define OW_READ()       ((BB_REG(PORT, ONEWIRE_PORT, ) >> ONEWIRE_BIT) & 1)
+
+#define SCL_LOW()       (BB_REG(TRIS, I2C_BB_SCL_PORT, CLR) = BB_MASK(I2C_BB_SCL_BIT))
+#define SCL_RELEASE()   (BB_REG(TRIS, I2C_BB_SCL_PORT, SET) = BB_MASK(I2C_BB_SCL_BIT))
+#define SCL_READ()      ((BB_REG(PORT, I2C_BB_SCL_PORT, ) >> I2C_BB_SCL_BIT) & 1)
+#define SDA_LOW()       (BB_REG(TRIS, I2C_BB_SDA_PORT, CLR) = BB_MASK(I2C_BB_SDA_BIT))
+#define SDA_RELEASE()   (BB_REG(TRIS, I2C_BB_SDA_PORT, SET) = BB_MASK(I2C_BB_SDA_BIT))
+#define SDA_READ()      ((BB_REG(PORT, I2C_BB_SDA_PORT, ) >> I2C_BB_SDA_BIT) & 1)
+
+/* Interrupts are masked per bit, the previous state is restored afterwards */
+#define BB_LOCK(status)     ((status) = __builtin_disable_interrupts())
+#define BB_UNLOCK(status)   do{ if((status) & 1) __builtin_enable_interrupts(); }while(0)
+
+/* Busy wait until ticks have elapsed from start, returns the exit stamp */
+static inline unsigned int wait_until(unsigned int start, unsigned int ticks){
+    unsigned int now;
+    while((now = _CP0_GET_COUNT()) - start < ticks);
+    return now;
+}
+
+static inline void wait_ticks(unsigned int ticks){
+    wait_until(_CP0_GET_COUNT(), ticks);
+}
+
+static unsigned int ticks_to_ns(unsigned int ticks){
+    return (unsigned int)((unsigned long long)ticks * 1000000000ULL / CORE_TIMER_FREQ);
+}
+
+static void timing_reset(bitbang_timing *t, unsigned int spec_min_ns, unsigned int spec_max_ns){
+    t->spec_min_ns = spec_min_ns;
+    t->spec_max_ns = spec_max_ns;
+    t->min_ns = 0xFFFFFFFF;
+    t->max_ns = 0;
+}
+
+static void timing_add(bitbang_timing *t, unsigned int ticks){
+    unsigned int ns = ticks_to_ns(ticks);
+    if(ns < t->min_ns) t->min_ns = ns;
+    if(ns > t->max_ns) t->max_ns = ns;
+}
+
+static unsigned char timing_check(const bitbang_timing *t, unsigned char count){
+    unsigned char i;
+    for(i = 0; i < count; i++)
+        if(t[i].min_ns < t[i].spec_min_ns || t[i].max_ns > t[i].spec_max_ns) return 0;
+    return 1;
+}
+
+/*
+ * Phase lengths of the last bit generated, in Core Timer ticks. Every stamp
+ * is read right after the store (or the PORTx read) making its edge, so the
+ * constant store-to-stamp delay cancels out and the differences are those
+ * of the edges on the pins, stretching and interrupts included.
+ */
+static unsigned int last_high, last_low;
+
+/*
+ * WS2812B: 1.25 us bit, T0H 0.4 us, T1H 0.8 us (+-150 ns), latch > 280 us.
+ */
+#define WS_T0H      NS_TO_TICKS(400)
+#define WS_T1H      NS_TO_TICKS(800)
+#define WS_TBIT     NS_TO_TICKS(1250)
+#define WS_RESET_NS 300000
+
+void ws2812_init(void){
+    WS_LOW();
+    BB_REG(TRIS, WS2812_PORT, CLR) = BB_MASK(WS2812_BIT);
+}
+
+/* Stamp of the last falling edge: the LOW phase lasts until the next rise */
+static unsigned int ws_fall;
+
+/* last_low is the LOW phase of the previous bit, ended by this rising edge */
+static inline void ws2812_bit(unsigned int high){
+    unsigned int status, rise, fall;
+    BB_LOCK(status);
+    WS_HIGH();
+    rise = _CP0_GET_COUNT();
+    wait_until(rise, high);
+    WS_LOW();
+    fall = _CP0_GET_COUNT();
+    BB_UNLOCK(status);
+    last_low = rise - ws_fall;
+    last_high = fall - rise;
+    ws_fall = fall;
+    wait_until(rise, WS_TBIT);
+}
+
+void ws2812_write(const unsigned char *data, unsigned int length){
+    unsigned char mask;
+    while(length--){
+        for(mask = 0x80; mask != 0; mask >>= 1)
+            ws2812_bit((*data & mask) ? WS_T1H : WS_T0H);
+        data++;
+    }
+    wait_ticks(NS_TO_TICKS(WS_RESET_NS));
+}
+
+#define WS_MEASURE_BITS 32
+
+unsigned char ws2812_measure(bitbang_timing report[WS2812_TIMINGS]){
+    unsigned short high[WS_MEASURE_BITS], low[WS_MEASURE_BITS];
+    unsigned int i;
+    timing_reset(&report[WS2812_T0H], 250, 550);
+    timing_reset(&report[WS2812_T1H], 650, 950);
+    timing_reset(&report[WS2812_T0L], 700, 1000);
+    timing_reset(&report[WS2812_T1L], 300, 600);
+    /* Raw stamps only between bits, as cheap as the loop of ws2812_write */
+    for(i = 0; i < WS_MEASURE_BITS; i++){
+        ws2812_bit((i & 1) ? WS_T1H : WS_T0H);
+        high[i] = last_high;
+        low[i] = last_low;
+    }
+    wait_ticks(NS_TO_TICKS(WS_RESET_NS));
+    for(i = 0; i < WS_MEASURE_BITS; i++){
+        timing_add(&report[(i & 1) ? WS2812_T1H : WS2812_T0H], high[i]);
+        /* low[0] is the latch time before the pattern */
+        if(i > 0) timing_add(&report[(i & 1) ? WS2812_T0L : WS2812_T1L], low[i]);
+    }
+    return timing_check(report, WS2812_TIMINGS);
+}
+
+/*
+ * 1-Wire standard speed, timings in us from the Maxim application note 126.
+ */
+#define OW_RESET_LOW    NS_TO_TICKS(480000)
+#define OW_PRESENCE     NS_TO_TICKS(70000)
+#define OW_RESET_TAIL   NS_TO_TICKS(410000)
+#define OW_W1_LOW       NS_TO_TICKS(6000)
+#define OW_W0_LOW       NS_TO_TICKS(60000)
+#define OW_SLOT         NS_TO_TICKS(70000)
+#define OW_READ_LOW     NS_TO_TICKS(6000)
+#define OW_READ_SAMPLE  NS_TO_TICKS(9000)
+
+static unsigned int last_sample;
+/* Stamp of the falling edge opening the last slot: a slot lasts until the next one */
+static unsigned int ow_fall;
+
+void onewire_init(void){
+    BB_REG(LAT, ONEWIRE_PORT, CLR) = BB_MASK(ONEWIRE_BIT);
+    OW_RELEASE();
+}
+
+unsigned char onewire_reset(void){
+    unsigned int status, start;
+    unsigned char presence;
+    OW_LOW();
+    wait_ticks(OW_RESET_LOW);
+    BB_LOCK(status);
+    start = _CP0_GET_COUNT();
+    OW_RELEASE();
+    wait_until(start, OW_PRESENCE);
+    presence = !OW_READ();
+    BB_UNLOCK(status);
+    wait_ticks(OW_RESET_TAIL);
+    return presence;
+}
+
+/* last_high is the length of the previous slot, ended by this falling edge */
+void onewire_write_bit(unsigned char bit){
+    unsigned int status, fall, release;
+    BB_LOCK(status);
+    OW_LOW();
+    fall = _CP0_GET_COUNT();
+    wait_until(fall, bit ? OW_W1_LOW : OW_W0_LOW);
+    OW_RELEASE();
+    release = _CP0_GET_COUNT();
+    BB_UNLOCK(status);
+    last_low = release - fall;
+    last_high = fall - ow_fall;
+    ow_fall = fall;
+    wait_until(fall, OW_SLOT);
+}
+
+unsigned char onewire_read_bit(void){
+    unsigned int status, fall, sample;
+    unsigned char bit;
+    BB_LOCK(status);
+    OW_LOW();
+    fall = _CP0_GET_COUNT();
+    wait_until(fall, OW_READ_LOW);
+    OW_RELEASE();
+    wait_until(fall, OW_READ_SAMPLE);
+    bit = OW_READ();
+    sample = _CP0_GET_COUNT();
+    BB_UNLOCK(status);
+    last_sample = sample - fall;
+    last_high = fall - ow_fall;
+    ow_fall = fall;
+    wait_until(fall, OW_SLOT);
+    return bit;
+}
+
+void onewire_write_byte(unsigned char value){
+    unsigned char i;
+    for(i = 0; i < 8; i++){
+        onewire_write_bit(value & 1);
+        value >>= 1;
+    }
+}
+
+unsigned char onewire_read_byte(void){
+    unsigned char i, value = 0;
+    for(i = 0; i < 8; i++)
+        value |= onewire_read_bit() << i;
+    return value;
+}
+
+unsigned char onewire_measure(bitbang_timing report[ONEWIRE_TIMINGS]){
+    unsigned char i;
+    timing_reset(&report[ONEWIRE_W0_LOW], 60000, 120000);
+    timing_reset(&report[ONEWIRE_W1_LOW], 1000, 15000);
+    timing_reset(&report[ONEWIRE_READ_SAMPLE], 1000, 15000);
+    timing_reset(&report[ONEWIRE_SLOT], 60000, 120000);
+    for(i = 0; i < 16; i++){
+        onewire_write_bit(i & 1);
+        timing_add(&report[(i & 1) ? ONEWIRE_W1_LOW : ONEWIRE_W0_LOW], last_low);
+        /* The first slot follows whatever ran before the measure */
+        if(i > 0) timing_add(&report[ONEWIRE_SLOT], last_high);
+        onewire_read_bit();
+        timing_add(&report[ONEWIRE_READ_SAMPLE], last_sample);
+        timing_add(&report[ONEWIRE_SLOT], last_high);
+    }
+    return timing_check(report, ONEWIRE_TIMINGS);
+}
+
+/*
+ * I2C: tLOW is the larger between half period and the spec minimum of the
+ * mode (4.7 us standard, 1.3 us fast), tHIGH takes the rest of the period.
+ */
+#define I2C_PERIOD_NS   (1000000000UL / I2C_BB_FREQ)
+#define I2C_SPEC_LOW_NS ((I2C_BB_FREQ > 100000UL) ? 1300 : 4700)
+#define I2C_SPEC_HIGH_NS ((I2C_BB_FREQ > 100000UL) ? 600 : 4000)
+#define I2C_LOW_NS      ((I2C_PERIOD_NS / 2 > I2C_SPEC_LOW_NS) ? I2C_PERIOD_NS / 2 : I2C_SPEC_LOW_NS)
+#define I2C_HIGH_NS     ((I2C_PERIOD_NS - I2C_LOW_NS > I2C_SPEC_HIGH_NS) ? I2C_PERIOD_NS - I2C_LOW_NS : I2C_SPEC_HIGH_NS)
+#define I2C_LOW         NS_TO_TICKS(I2C_LOW_NS)
+#define I2C_HIGH        NS_TO_TICKS(I2C_HIGH_NS)
+/* Longest clock stretching accepted from a slave */
+#define I2C_STRETCH     NS_TO_TICKS(1000000)
+
+/* Stamp of the last SCL falling edge, start of the LOW phase */
+static unsigned int scl_fall;
+
+static void i2c_bb_scl_low(void){
+    SCL_LOW();
+    scl_fall = _CP0_GET_COUNT();
+}
+
+/*
+ * Releases SCL at the end of the LOW phase and waits for the line to rise.
+ * A slave may stretch the clock up to I2C_STRETCH: the line is polled with
+ * interrupts enabled, masking them only for the read, and the function
+ * returns 1 with them masked from the observed rising edge on, the edge
+ * stamped in rise. It returns 0 with interrupts restored if SCL is still
+ * LOW after I2C_STRETCH.
+ */
+static unsigned char i2c_bb_scl_high(unsigned int *status, unsigned int *rise){
+    unsigned int start, now;
+    wait_until(scl_fall, I2C_LOW);
+    SCL_RELEASE();
+    start = _CP0_GET_COUNT();
+    while(1){
+        BB_LOCK(*status);
+        if(SCL_READ()) break;
+        now = _CP0_GET_COUNT();
+        BB_UNLOCK(*status);
+        if(now - start > I2C_STRETCH) return 0;
+    }
+    *rise = _CP0_GET_COUNT();
+    last_low = *rise - scl_fall;
+    return 1;
+}
+
+/* Clocks bit out and the level of SDA in */
+static unsigned char i2c_bb_bit(unsigned char bit, unsigned char *sampled){
+    unsigned int status, rise;
+    if(bit) SDA_RELEASE();
+    else SDA_LOW();
+    if(!i2c_bb_scl_high(&status, &rise)) return I2C_BB_TIMEOUT;
+    wait_until(rise, I2C_HIGH);
+    *sampled = SDA_READ();
+    i2c_bb_scl_low();
+    BB_UNLOCK(status);
+    last_high = scl_fall - rise;
+    return I2C_BB_OK;
+}
+
+/* Both lines back to the pull-ups, without a STOP: SCL is held by a slave */
+static void i2c_bb_release(void){
+    SDA_RELEASE();
+    SCL_RELEASE();
+}
+
+void i2c_bb_init(void){
+    BB_REG(LAT, I2C_BB_SCL_PORT, CLR) = BB_MASK(I2C_BB_SCL_BIT);
+    BB_REG(LAT, I2C_BB_SDA_PORT, CLR) = BB_MASK(I2C_BB_SDA_BIT);
+    i2c_bb_release();
+}
+
+unsigned char i2c_bb_start(void){
+    unsigned int status, rise;
+    /* Works as repeated START too: bring SDA up while SCL is LOW first */
+    SDA_RELEASE();
+    if(!i2c_bb_scl_high(&status, &rise)) return I2C_BB_TIMEOUT;
+    BB_UNLOCK(status);
+    wait_ticks(I2C_HIGH);
+    SDA_LOW();
+    wait_ticks(I2C_HIGH);
+    i2c_bb_scl_low();
+    return I2C_BB_OK;
+}
+
+unsigned char i2c_bb_stop(void){
+    unsigned int status, rise;
+    SDA_LOW();
+    if(!i2c_bb_scl_high(&status, &rise)){
+        i2c_bb_release();
+        return I2C_BB_TIMEOUT;
+    }
+    BB_UNLOCK(status);
+    wait_ticks(I2C_HIGH);
+    SDA_RELEASE();
+    wait_ticks(I2C_LOW);
+    return I2C_BB_OK;
+}
+
+unsigned char i2c_bb_write_byte(unsigned char value){
+    unsigned char mask, sampled, result;
+    for(mask = 0x80; mask != 0; mask >>= 1)
+        if((result = i2c_bb_bit(value & mask, &sampled)) != I2C_BB_OK) return result;
+    if((result = i2c_bb_bit(1, &sampled)) != I2C_BB_OK) return result;
+    return sampled ? I2C_BB_NACK : I2C_BB_OK;
+}
+
+unsigned char i2c_bb_read_byte(unsigned char *value, unsigned char ack){
+    unsigned char i, sampled, result;
+    *value = 0;
+    for(i = 0; i < 8; i++){
+        if((result = i2c_bb_bit(1, &sampled)) != I2C_BB_OK) return result;
+        *value = (*value << 1) | sampled;
+    }
+    return i2c_bb_bit(!ack, &sampled);
+}
+
+/* Closes a transfer: STOP after success or NACK, lines released after a timeout */
+static unsigned char i2c_bb_end(unsigned char result){
+    unsigned char stop;
+    if(result == I2C_BB_TIMEOUT){
+        i2c_bb_release();
+        return result;
+    }
+    stop = i2c_bb_stop();
+    return result != I2C_BB_OK ? result : stop;
+}
+
+unsigned char i2c_bb_write(unsigned char address, const unsigned char *data, unsigned int length){
+    unsigned char result = i2c_bb_start();
+    if(result == I2C_BB_OK) result = i2c_bb_write_byte(address << 1);
+    while(result == I2C_BB_OK && length--) result = i2c_bb_write_byte(*data++);
+    return i2c_bb_end(result);
+}
+
+unsigned char i2c_bb_read(unsigned char address, unsigned char *data, unsigned int length){
+    unsigned char result = i2c_bb_start();
+    if(result == I2C_BB_OK) result = i2c_bb_write_byte((address << 1) | 1);
+    while(result == I2C_BB_OK && length){
+        result = i2c_bb_read_byte(data++, length > 1);
+        length--;
+    }
+    return i2c_bb_end(result);
+}
+
+unsigned char i2c_bb_measure(bitbang_timing report[I2C_BB_TIMINGS]){
+    unsigned char mask, sampled, result;
+    timing_reset(&report[I2C_BB_LOW], I2C_SPEC_LOW_NS, 0xFFFFFFFF);
+    timing_reset(&report[I2C_BB_HIGH], I2C_SPEC_HIGH_NS, 0xFFFFFFFF);
+    result = i2c_bb_start();
+    /* Read from the reserved address 0x7F: no slave answers it */
+    for(mask = 0x80; mask != 0 && result == I2C_BB_OK; mask >>= 1){
+        if((result = i2c_bb_bit(1, &sampled)) != I2C_BB_OK) break;
+        timing_add(&report[I2C_BB_LOW], last_low);
+        timing_add(&report[I2C_BB_HIGH], last_high);
+    }
+    if(result == I2C_BB_OK) result = i2c_bb_bit(1, &sampled);
+    if(i2c_bb_end(result) != I2C_BB_OK) return 0;
+    return timing_check(report, I2C_BB_TIMINGS);
+}
@@ -0,0 +1,348 @@
+#ifndef _BITBANG_H
+#define _BITBANG_H
+
+#include "interrupts.h"
+
+/*
+ * Pins of the bit-bang engines are compile-time constants: a port letter and
+ * a bit number, overridable from the project settings (-DWS2812_BIT=3). Every
+ * edge is then a single store to a fixed SFR address, with no pin or io_port
+ * pointer to follow. The pins must be digital (not selected as ANALOGIC).
+ */
+#ifndef WS2812_PORT
+#define WS2812_PORT B
+#endif
+#ifndef WS2812_BIT
+#define WS2812_BIT 5
+#endif
+
+#ifndef ONEWIRE_PORT
+#define ONEWIRE_PORT B
+#endif
+#ifndef ONEWIRE_BIT
+#define ONEWIRE_BIT 7
+#endif
+
+#ifndef I2C_BB_SCL_PORT
+#define I2C_BB_SCL_PORT B
+#endif
+#ifndef I2C_BB_SCL_BIT
+#define I2C_BB_SCL_BIT 8
+#endif
+#ifndef I2C_BB_SDA_PORT
+#define I2C_BB_SDA_PORT B
+#endif
+#ifndef I2C_BB_SDA_BIT
+#define I2C_BB_SDA_BIT 9
+#endif
+
+/**
+ @Summary
+    Bus frequency of the bit-banged I2C master, in Hz (up to 400 kHz)
+ */
+#ifndef I2C_BB_FREQ
+#define I2C_BB_FREQ 100000UL
+#endif
+
+/**
+ @Summary
+    Conversion from nanoseconds to Core Timer ticks, rounded to the nearest
+    tick. With constant arguments it folds at compile time.
+ */
+#define NS_TO_TICKS(ns) ((unsigned int)(((unsigned long long)(ns) * CORE_TIMER_FREQ + 500000000ULL) / 1000000000ULL))
+
+/**
+ @Summary
+    One measured timing of a bit-bang engine, checked against its spec window
+ @Description
+    The engines stamp the Core Timer right after every edge they make, and
+    I2C stamps the SCL rising edge when it reads the line HIGH, so the phases
+    are measured edge to edge, clock stretching and interrupts between bits
+    included: the <code>*_measure</code> functions run a test pattern through
+    the same bit routines used for real transfers and collect the shortest
+    and longest value of every phase. Resolution is one Core Timer tick
+    (50 ns at 40 MHz).
+ @Remarks
+    <ul>
+        <li><code>unsigned int spec_min_ns</code> : shortest value allowed by the protocol</li>
+        <li><code>unsigned int spec_max_ns</code> : longest value allowed by the protocol</li>
+        <li><code>unsigned int min_ns</code> : shortest value measured</li>
+        <li><code>unsigned int max_ns</code> : longest value measured</li>
+    </ul>
+ */
+typedef struct{
+    unsigned int spec_min_ns;
+    unsigned int spec_max_ns;
+    unsigned int min_ns;
+    unsigned int max_ns;
+} bitbang_timing;
+
+#define WS2812_T0H 0
+#define WS2812_T1H 1
+#define WS2812_T0L 2
+#define WS2812_T1L 3
+#define WS2812_TIMINGS 4
+
+#define ONEWIRE_W0_LOW 0
+#define ONEWIRE_W1_LOW 1
+#define ONEWIRE_READ_SAMPLE 2
+#define ONEWIRE_SLOT 3
+#define ONEWIRE_TIMINGS 4
+
+#define I2C_BB_LOW 0
+#define I2C_BB_HIGH 1
+#define I2C_BB_TIMINGS 2
+
+/**
+ @Summary
+    Results of the I2C functions. I2C_BB_TIMEOUT: a slave held SCL LOW
+    for more than 1 ms; the transfer is abandoned and both lines released,
+    without STOP.
+ */
+#define I2C_BB_OK      0
+#define I2C_BB_NACK    1
+#define I2C_BB_TIMEOUT 2
+
+/**
+@Function
+    void ws2812_init(void)
+
+@Summary
+    The function sets the WS2812 pin as OUTPUT, driven LOW.
+*/
+extern void ws2812_init(void);
+
+/**
+@Function
+    void ws2812_write(const unsigned char *data, unsigned int length)
+
+@Summary
+    The function sends <code>length</code> bytes to a WS2812 chain, MSB first,
+    and then holds the line LOW for the latch time.
+
+@Description
+    Every bit is timed against Core Timer deadlines taken at its rising edge,
+    so the store latency does not pile up. Interrupts are masked for the HIGH
+    phase of each bit only; they are served during the LOW phase.
+
+@Precondition
+    <code>ws2812_init</code>. Bytes are in the order of the chain (G, R, B for
+    each LED).
+
+@Remarks
+    An interrupt handler longer than about 5 us, served during a LOW phase,
+    is taken as a latch by the LEDs and breaks the frame.
+
+@Example
+    @code
+    unsigned char leds[3 * 8];
+    ws2812_write(leds, sizeof(leds));
+*/
+extern void ws2812_write(const unsigned char *data, unsigned int length);
+
+/**
+@Function
+    unsigned char ws2812_measure(bitbang_timing report[WS2812_TIMINGS])
+
+@Summary
+    The function sends a test pattern and reports T0H, T1H, T0L and T1L.
+
+@Returns
+<ul>
+    <li><code>1</code> if every timing is within the WS2812B datasheet window</li>
+    <li><code>0</code> otherwise</li>
+</ul>
+*/
+extern unsigned char ws2812_measure(bitbang_timing report[WS2812_TIMINGS]);
+
+/**
+@Function
+    void onewire_init(void)
+
+@Summary
+    The function releases the 1-Wire line. The line is open-drain: the latch
+    is kept LOW and TRIS switches between driving LOW and releasing it to the
+    external pull-up.
+*/
+extern void onewire_init(void);
+
+/**
+@Function
+    unsigned char onewire_reset(void)
+
+@Summary
+    The function sends a reset pulse and returns 1 if a device answered with
+    a presence pulse.
+*/
+extern unsigned char onewire_reset(void);
+
+/**
+@Function
+    void onewire_write_bit(unsigned char bit)
+
+@Summary
+    The function sends one write slot (standard speed).
+*/
+extern void onewire_write_bit(unsigned char bit);
+
+/**
+@Function
+    unsigned char onewire_read_bit(void)
+
+@Summary
+    The function sends one read slot and returns the bit sampled.
+*/
+extern unsigned char onewire_read_bit(void);
+
+/**
+@Function
+    void onewire_write_byte(unsigned char value)
+
+@Summary
+    The function sends a byte, LSB first.
+*/
+extern void onewire_write_byte(unsigned char value);
+
+/**
+@Function
+    unsigned char onewire_read_byte(void)
+
+@Summary
+    The function reads a byte, LSB first.
+*/
+extern unsigned char onewire_read_byte(void);
+
+/**
+@Function
+    unsigned char onewire_measure(bitbang_timing report[ONEWIRE_TIMINGS])
+
+@Summary
+    The function runs write and read slots and reports their timings.
+
+@Remarks
+    Write slots are sent without a reset pulse, so attached devices ignore them.
+
+@Returns
+<ul>
+    <li><code>1</code> if every timing is within the standard speed window</li>
+    <li><code>0</code> otherwise</li>
+</ul>
+*/
+extern unsigned char onewire_measure(bitbang_timing report[ONEWIRE_TIMINGS]);
+
+/**
+@Function
+    void i2c_bb_init(void)
+
+@Summary
+    The function releases SCL and SDA. Both lines are open-drain and need
+    external pull-ups; SCL is read back so that clock stretching is honored.
+
+@Remarks
+    Interrupts are masked only from each SCL rising edge to the falling one:
+    the LOW phase and a slave stretching the clock are waited for with
+    interrupts enabled.
+*/
+extern void i2c_bb_init(void);
+
+/**
+@Function
+    unsigned char i2c_bb_start(void)
+
+@Summary
+    The function sends a START (or a repeated START) condition.
+
+@Returns
+    I2C_BB_OK, I2C_BB_TIMEOUT if SCL is held LOW.
+*/
+extern unsigned char i2c_bb_start(void);
+
+/**
+@Function
+    unsigned char i2c_bb_stop(void)
+
+@Summary
+    The function sends a STOP condition.
+
+@Returns
+    I2C_BB_OK, I2C_BB_TIMEOUT if SCL is held LOW; the lines are then
+    released without STOP.
+*/
+extern unsigned char i2c_bb_stop(void);
+
+/**
+@Function
+    unsigned char i2c_bb_write_byte(unsigned char value)
+
+@Summary
+    The function clocks out a byte.
+
+@Returns
+    I2C_BB_OK if the slave acknowledged it, I2C_BB_NACK or I2C_BB_TIMEOUT.
+*/
+extern unsigned char i2c_bb_write_byte(unsigned char value);
+
+/**
+@Function
+    unsigned char i2c_bb_read_byte(unsigned char *value, unsigned char ack)
+
+@Summary
+    The function clocks in a byte and answers with ACK (<code>ack</code> = 1)
+    or NACK (<code>ack</code> = 0, last byte of a read).
+
+@Returns
+    I2C_BB_OK, I2C_BB_TIMEOUT if a slave stretched the clock too long.
+*/
+extern unsigned char i2c_bb_read_byte(unsigned char *value, unsigned char ack);
+
+/**
+@Function
+    unsigned char i2c_bb_write(unsigned char address, const unsigned char *data, unsigned int length)
+
+@Summary
+    The function writes a buffer to the slave at the 7-bit <code>address</code>.
+
+@Returns
+<ul>
+    <li><code>I2C_BB_OK</code> if every byte has been acknowledged</li>
+    <li><code>I2C_BB_NACK</code> otherwise; a STOP is sent anyway</li>
+    <li><code>I2C_BB_TIMEOUT</code> if a slave held SCL LOW; the transfer is
+        abandoned and the lines released</li>
+</ul>
+*/
+extern unsigned char i2c_bb_write(unsigned char address, const unsigned char *data, unsigned int length);
+
+/**
+@Function
+    unsigned char i2c_bb_read(unsigned char address, unsigned char *data, unsigned int length)
+
+@Summary
+    The function reads a buffer from the slave at the 7-bit <code>address</code>.
+
+@Returns
+<ul>
+    <li><code>I2C_BB_OK</code> if the slave acknowledged its address</li>
+    <li><code>I2C_BB_NACK</code> otherwise; a STOP is sent anyway</li>
+    <li><code>I2C_BB_TIMEOUT</code> if a slave held SCL LOW; the transfer is
+        abandoned and the lines released</li>
+</ul>
+*/
+extern unsigned char i2c_bb_read(unsigned char address, unsigned char *data, unsigned int length);
+
+/**
+@Function
+    unsigned char i2c_bb_measure(bitbang_timing report[I2C_BB_TIMINGS])
+
+@Summary
+    The function clocks a read request to the reserved address 0x7F, which
+    no slave acknowledges, and reports the SCL LOW and HIGH times.
+
+@Returns
+<ul>
+    <li><code>1</code> if tLOW and tHIGH respect the minimum of the selected mode</li>
+    <li><code>0</code> otherwise, or if SCL is held LOW</li>
+</ul>
+*/
+extern unsigned char i2c_bb_measure(bitbang_timing report[I2C_BB_TIMINGS]);
+
+#endif
@@ -0,0 +1,149 @@
+#include <xc.h>
+#include "counter.h"
+
+/* TxCON */
+#define TIMER_TCS (1 << 1)
+#define TIMER_T32 (1 << 3)
+#define TIMER_ON  (1 << 15)
+
+#define COUNTER_TIMERS 4
+
+/* Timer2 to Timer5, their clock inputs and the counter their period match extends */
+static const timer *const timers[COUNTER_TIMERS] = { &T2, &T3, &T4, &T5 };
+static const peripheral *const clocks[COUNTER_TIMERS] = { &T2CK, &T3CK, &T4CK, &T5CK };
+static counter *volatile owners[COUNTER_TIMERS];
+
+static void overflow_t2(void){ owners[0]->overflows++; }
+static void overflow_t3(void){ owners[1]->overflows++; }
+static void overflow_t4(void){ owners[2]->overflows++; }
+static void overflow_t5(void){ owners[3]->overflows++; }
+
+static const interrupt_handler overflow_handlers[COUNTER_TIMERS] = {
+    overflow_t2, overflow_t3, overflow_t4, overflow_t5
+};
+
+static unsigned char slot_of(const timer *t){
+    unsigned char i;
+    for(i = 0; i < COUNTER_TIMERS; i++)
+        if(timers[i] == t) break;
+    return i;
+}
+
+/*
+ * A timer is taken when a counter runs on it, alone or as the low half of a
+ * pair, or when another module (scan, a gate) turned it ON. The high half of
+ * a pair stays OFF: the T32 bit of the even timer tells it is in use.
+ */
+static unsigned char taken(unsigned char slot){
+    unsigned char i;
+    for(i = 0; i < COUNTER_TIMERS; i++)
+        if(owners[i] != NULL && (i == slot || owners[i]->t == timers[slot])) return 1;
+    if(*(timers[slot]->con) & TIMER_ON) return 1;
+    if((slot & 1) && (*(timers[slot - 1]->con) & (TIMER_ON | TIMER_T32)) == (TIMER_ON | TIMER_T32)) return 1;
+    return 0;
+}
+
+unsigned char counter_init(counter *c, const timer *t, const pin *input, unsigned char width, unsigned int prescaler){
+    unsigned char slot = slot_of(t), overflow_slot;
+
+    if(slot == COUNTER_TIMERS) return 0;
+    if(width == COUNTER_32BIT){
+        if(slot & 1) return 0; /* Pairs are Timer2/3 and Timer4/5 */
+        overflow_slot = slot + 1;
+    }
+    else if(width == COUNTER_16BIT) overflow_slot = slot;
+    else return 0;
+    if(taken(slot) || taken(overflow_slot)) return 0;
+    /* Type B prescalers: powers of two up to 64, then 256 */
+    if(prescaler == 0 || prescaler > 256 || prescaler == 128 || (prescaler & (prescaler - 1))) return 0;
+    if(!pin_assign_peripheral(input, clocks[slot])) return 0;
+    pin_set_direction(input, INPUT);
+    pin_select_working_mode(input, DIGITAL);
+
+    *(t->con) = 0;
+    if(width == COUNTER_32BIT) *(timers[overflow_slot]->con) = 0;
+    timer_set_prescaler(t, prescaler);
+    *(t->con_set) = TIMER_TCS | (width == COUNTER_32BIT ? TIMER_T32 : 0);
+    *(t->pr) = (width == COUNTER_32BIT) ? 0xFFFFFFFF : 0xFFFF;
+    *(t->tmr) = 0;
+
+    c->t = t;
+    c->overflow = timers[overflow_slot]->irq;
+    c->width = width;
+    c->prescaler = prescaler;
+    c->overflows = 0;
+    c->hz = 0;
+    c->fresh = 0;
+    owners[overflow_slot] = c;
+    interrupt_configure(c->overflow, TIMER_INTERRUPT_PRIORITY, 0);
+    interrupt_attach(c->overflow, overflow_handlers[overflow_slot]);
+    interrupt_enable(c->overflow, ON);
+
+    /* The count is 0 now: the first window starts here */
+    c->gate_count = 0;
+    c->gate_stamp = _CP0_GET_COUNT();
+    timer_start(t);
+    return 1;
+}
+
+unsigned long long counter_read(counter *c){
+    unsigned int status, high, low;
+    status = __builtin_disable_interrupts();
+    high = c->overflows;
+    low = *(c->t->tmr);
+    /* A wrap whose handler is pending leaves a small count behind */
+    if(interrupt_pending(c->overflow) && low < (c->width == COUNTER_32BIT ? 0x80000000u : 0x8000u)) high++;
+    if(status & 1) __builtin_enable_interrupts();
+    return (((unsigned long long)high << c->width) | low) * c->prescaler;
+}
+
+static void gate_tick(void){
+    unsigned char i;
+    counter *c;
+    unsigned long long count;
+    unsigned int stamp, ticks;
+    for(i = 0; i < COUNTER_TIMERS; i++){
+        if((c = owners[i]) == NULL) continue;
+        count = counter_read(c);
+        stamp = _CP0_GET_COUNT();
+        ticks = stamp - c->gate_stamp;
+        if(ticks == 0) continue;
+        c->hz = (unsigned long)(((count - c->gate_count) * CORE_TIMER_FREQ + ticks / 2) / ticks);
+        c->fresh = 1;
+        c->gate_count = count;
+        c->gate_stamp = stamp;
+    }
+}
+
+unsigned char counter_gate_start(const timer *gate, unsigned long window_us){
+    if(!timer_set_period_us(gate, window_us)) return 0;
+    interrupt_configure(gate->irq, TIMER_INTERRUPT_PRIORITY, 0);
+    interrupt_attach(gate->irq, gate_tick);
+    interrupt_enable(gate->irq, ON);
+    timer_start(gate);
+    return 1;
+}
+
+unsigned char counter_frequency(counter *c, unsigned long *hz){
+    unsigned char fresh = c->fresh;
+    if(fresh) c->fresh = 0;
+    *hz = c->hz;
+    return fresh;
+}
+
+void counter_stop(counter *c){
+    unsigned char slot = slot_of(c->t), overflow_slot;
+    if(slot == COUNTER_TIMERS) return;
+    overflow_slot = c->width == COUNTER_32BIT ? slot + 1 : slot;
+    /* Stopped already, or never started: the timers may belong to someone else now */
+    if(owners[overflow_slot] != c) return;
+    timer_stop(c->t);
+    if(c->width == COUNTER_32BIT){
+        /* Release the pair: the odd timer is usable alone again */
+        *(c->t->con_clr) = TIMER_T32;
+        *(timers[overflow_slot]->con) = 0;
+    }
+    interrupt_enable(c->overflow, OFF);
+    interrupt_attach(c->overflow, NULL);
+    owners[overflow_slot] = NULL;
+}
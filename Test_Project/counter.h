@@ -0,0 +1,174 @@
+#ifndef _COUNTER_H
+#define _COUNTER_H
+
+#include "digital_io.h"
+#include "timers.h"
+
+/**
+ @Summary
+    Width of the hardware counter: one 16-bit timer, or a Timer2/3 (Timer4/5)
+    pair clocked by T2CK (T4CK)
+ */
+#define COUNTER_16BIT 16
+#define COUNTER_32BIT 32
+
+/**
+ @Summary
+    The struct represents an event counter clocked by a TxCK pin
+ @Description
+    The struct is allocated by the user and filled by <code>counter_init</code>.
+    The timer counts the edges in hardware, with no CPU work per edge; the
+    period match interrupt only extends the count every 2^16 (2^32) timer
+    counts. With a gate running, the frequency is computed once per window.
+ @Remarks
+    <ul>
+        <li><code>const timer *t</code> : timer counting the edges</li>
+        <li><code>const interrupt_source *overflow</code> : period match source
+            (the odd timer of a pair)</li>
+        <li><code>unsigned char width</code> : COUNTER_16BIT or COUNTER_32BIT</li>
+        <li><code>unsigned short prescaler</code> : edges per timer count</li>
+        <li><code>volatile unsigned int overflows</code> : wraps of the timer</li>
+        <li><code>unsigned long long gate_count</code>, <code>unsigned int gate_stamp</code> :
+            count and Core Timer stamp at the previous gate</li>
+        <li><code>volatile unsigned long hz</code> : frequency over the last window</li>
+        <li><code>volatile unsigned char fresh</code> : <code>hz</code> not read yet</li>
+    </ul>
+ */
+typedef struct{
+    const timer *t;
+    const interrupt_source *overflow;
+    unsigned char width;
+    unsigned short prescaler;
+    volatile unsigned int overflows;
+    unsigned long long gate_count;
+    unsigned int gate_stamp;
+    volatile unsigned long hz;
+    volatile unsigned char fresh;
+} counter;
+
+/**
+@Function
+    unsigned char counter_init(counter *c, const timer *t, const pin *input, unsigned char width, unsigned int prescaler)
+
+@Summary
+    The function maps <code>input</code> to the TxCK input of the timer and
+    starts counting its rising edges from 0.
+
+@Description
+    The timer runs from the external clock (TCS), with PRx at its maximum and
+    the period match interrupt extending the count. The input is synchronized
+    to PBCLK after the prescaler: without prescaler keep the signal below
+    PB_FREQ / 2, a prescaler of N raises the limit about N times, up to the
+    TxCK pin limit of the datasheet.
+
+@Precondition
+    The timer and its period match vector are not used by other modules.
+    Call <code>interrupt_init</code> if not already done.
+
+@Parameters
+    @param c the counter struct to fill
+    @param t T2 to T5; T2 or T4 for COUNTER_32BIT, which also takes T3 or T5
+    @param input pin in the PPS group of the TxCK input (T2CK group 1, T3CK
+        group 2, T4CK group 3, T5CK group 4)
+    @param width COUNTER_16BIT or COUNTER_32BIT
+    @param prescaler 1, 2, 4, 8, 16, 32, 64 or 256
+
+@Returns
+<ul>
+    <li><code>1</code> if the counter is running</li>
+    <li><code>0</code> if the timer, width, prescaler or pin is not allowed,
+        or if the timer (or the other timer of the pair, for COUNTER_32BIT)
+        is used by a running counter or already ON for another module (scan,
+        a gate); nothing is done</li>
+</ul>
+
+@Example
+    @code
+    counter c;
+    counter_init(&c, &T2, &RB3, COUNTER_32BIT, 8); //RB3 as T2CK, Timer2/3 pair
+*/
+extern unsigned char counter_init(counter *c, const timer *t, const pin *input, unsigned char width, unsigned int prescaler);
+
+/**
+@Function
+    unsigned long long counter_read(counter *c)
+
+@Summary
+    The function returns the edges counted since <code>counter_init</code>,
+    without blocking.
+
+@Description
+    The overflow count and the timer are read with interrupts masked for a
+    few instructions; a wrap whose handler has not run yet is accounted from
+    the pending flag. The result has the resolution of the prescaler.
+
+@Remarks
+    Not to be called from handlers above TIMER_INTERRUPT_PRIORITY.
+*/
+extern unsigned long long counter_read(counter *c);
+
+/**
+@Function
+    unsigned char counter_gate_start(const timer *gate, unsigned long window_us)
+
+@Summary
+    The function starts the reference window measuring the frequency of
+    every counter.
+
+@Description
+    At every period of <code>gate</code> the handler reads each counter and
+    the Core Timer: the frequency is the count difference over the stamp
+    difference, so the latency of the handler does not bias the result. The
+    resolution is about 1 / window (1 Hz with a 1 s window).
+
+@Parameters
+    @param gate timer pacing the windows, not used by a counter
+    @param window_us length of the window, up to 65536 * 256 PBCLK cycles
+
+@Returns
+<ul>
+    <li><code>1</code> if the gate is running</li>
+    <li><code>0</code> if the window does not fit the timer</li>
+</ul>
+
+@Example
+    @code
+    counter_gate_start(&T1, 100000); //10 measures per second, 10 Hz resolution
+*/
+extern unsigned char counter_gate_start(const timer *gate, unsigned long window_us);
+
+/**
+@Function
+    unsigned char counter_frequency(counter *c, unsigned long *hz)
+
+@Summary
+    The function returns the frequency measured over the last window,
+    without blocking.
+
+@Returns
+<ul>
+    <li><code>1</code> if a window ended since the previous call; <code>hz</code> is filled</li>
+    <li><code>0</code> otherwise; <code>hz</code> holds the previous value
+        (0 before the first complete window)</li>
+</ul>
+
+@Example
+    @code
+    unsigned long hz;
+    if(counter_frequency(&c, &hz)) ...
+*/
+extern unsigned char counter_frequency(counter *c, unsigned long *hz);
+
+/**
+@Function
+    void counter_stop(counter *c)
+
+@Summary
+    The function stops the timer and detaches the counter; the count is kept.
+    A COUNTER_32BIT pair is split again, both timers can be reused. Does
+    nothing if the counter is not running, so a second call cannot stop a
+    timer another module took in between.
+*/
+extern void counter_stop(counter *c);
+
+#endif
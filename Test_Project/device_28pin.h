@@ -0,0 +1,110 @@
+/* Generated by host/devgen from pic32mx1xx_28pin.csv, do not edit */
+#ifndef _DEVICE_28PIN_H
+#define _DEVICE_28PIN_H
+
+/*
+ * PIC32MX1xx 28-pin SPDIP/SOIC/SSOP/QFN
+ */
+
+#define IO_PORTS 2
+
+#define PIN_RA0  1
+#define PIN_RA1  2
+#define PIN_RA2  3
+#define PIN_RA3  4
+#define PIN_RA4  5
+#define PIN_RB0  6
+#define PIN_RB1  7
+#define PIN_RB2  8
+#define PIN_RB3  9
+#define PIN_RB4  10
+#define PIN_RB5  11
+#define PIN_RB6  12
+#define PIN_RB7  13
+#define PIN_RB8  14
+#define PIN_RB9  15
+#define PIN_RB10 16
+#define PIN_RB11 17
+#define PIN_RB12 18
+#define PIN_RB13 19
+#define PIN_RB14 20
+#define PIN_RB15 21
+#define PIN_COUNT 22
+
+/* Capabilities of the pins of each port */
+#define RA_PIN_MASK          0x001F
+#define RA_ANALOG_MASK       0x0003
+#define RA_5V_TOLERANT_MASK  0x0000
+#define RA_REMAPPABLE_MASK   0x001F
+#define RB_PIN_MASK          0xFFFF
+#define RB_ANALOG_MASK       0xF00F
+#define RB_5V_TOLERANT_MASK  0x0FE0
+#define RB_REMAPPABLE_MASK   0xEFFF
+
+extern const io_port RA;
+extern const io_port RB;
+
+extern const pin RA0;
+extern const pin RA1;
+extern const pin RA2;
+extern const pin RA3;
+extern const pin RA4;
+
+extern const pin RB0;
+extern const pin RB1;
+extern const pin RB2;
+extern const pin RB3;
+extern const pin RB4;
+extern const pin RB5;
+extern const pin RB6;
+extern const pin RB7;
+extern const pin RB8;
+extern const pin RB9;
+extern const pin RB10;
+extern const pin RB11;
+extern const pin RB12;
+extern const pin RB13;
+extern const pin RB14;
+extern const pin RB15;
+
+extern const peripheral INT1;
+extern const peripheral INT2;
+extern const peripheral INT3;
+extern const peripheral INT4;
+extern const peripheral T2CK;
+extern const peripheral T3CK;
+extern const peripheral T4CK;
+extern const peripheral T5CK;
+extern const peripheral IC1;
+extern const peripheral IC2;
+extern const peripheral IC3;
+extern const peripheral IC4;
+extern const peripheral IC5;
+extern const peripheral OC1;
+extern const peripheral OC2;
+extern const peripheral OC3;
+extern const peripheral OC4;
+extern const peripheral OC5;
+extern const peripheral REFCLKI;
+extern const peripheral REFCLKO;
+extern const peripheral U1CTS;
+extern const peripheral U1RTS;
+extern const peripheral U1RX;
+extern const peripheral U1TX;
+extern const peripheral U2CTS;
+extern const peripheral U2RTS;
+extern const peripheral U2RX;
+extern const peripheral U2TX;
+extern const peripheral SDI1;
+extern const peripheral SDO1;
+extern const peripheral SS1;
+extern const peripheral SDI2;
+extern const peripheral SDO2;
+extern const peripheral SS2;
+extern const peripheral OCFA;
+extern const peripheral OCFB;
+extern const peripheral C1OUT;
+extern const peripheral C2OUT;
+extern const peripheral C3OUT;
+
+#endif
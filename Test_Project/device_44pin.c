@@ -0,0 +1,101 @@
+/* Generated by host/devgen from pic32mx1xx_44pin.csv, do not edit */
+#include <xc.h>
+#include "digital_io.h"
+
+#if DEVICE_PINS == 44
+
+const peripheral INT1 =     { &INT1R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral INT2 =     { &INT2R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral INT3 =     { &INT3R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+const peripheral INT4 =     { &INT4R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral T2CK =     { &T2CKR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral T3CK =     { &T3CKR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+const peripheral T4CK =     { &T4CKR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral T5CK =     { &T5CKR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral IC1 =      { &IC1R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral IC2 =      { &IC2R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral IC3 =      { &IC3R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+const peripheral IC4 =      { &IC4R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral IC5 =      { &IC5R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral OC1 =      { NULL, 5, OUTPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral OC2 =      { NULL, 5, OUTPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+const peripheral OC3 =      { NULL, 5, OUTPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral OC4 =      { NULL, 5, OUTPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral OC5 =      { NULL, 6, OUTPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral REFCLKI =  { &REFCLKIR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral REFCLKO =  { NULL, 7, OUTPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral U1CTS =    { &U1CTSR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+const peripheral U1RTS =    { NULL, 1, OUTPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral U1RX =     { &U1RXR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral U1TX =     { NULL, 1, OUTPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral U2CTS =    { &U2CTSR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral U2RTS =    { NULL, 2, OUTPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral U2RX =     { &U2RXR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+const peripheral U2TX =     { NULL, 2, OUTPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral SDI1 =     { &SDI1R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+const peripheral SDO1 =     { NULL, 3, OUTPUT, PPS_IN_GROUP(PPS_GROUP2) | PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral SS1 =      { &SS1R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral SDI2 =     { &SDI2R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral SDO2 =     { NULL, 4, OUTPUT, PPS_IN_GROUP(PPS_GROUP2) | PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral SS2 =      { &SS2R, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral OCFA =     { &OCFAR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral OCFB =     { &OCFBR, NONE, INPUT, PPS_IN_GROUP(PPS_GROUP3) } ;
+const peripheral C1OUT =    { NULL, 7, OUTPUT, PPS_IN_GROUP(PPS_GROUP4) } ;
+const peripheral C2OUT =    { NULL, 7, OUTPUT, PPS_IN_GROUP(PPS_GROUP1) } ;
+const peripheral C3OUT =    { NULL, 7, OUTPUT, PPS_IN_GROUP(PPS_GROUP2) } ;
+
+const io_port RA = { &ANSELA, 0x00, 0 } ;
+const io_port RB = { &ANSELB, 0x2C, 1 } ;
+const io_port RC = { &ANSELC, 0x6C, 2 } ;
+
+const io_port *const port_table[IO_PORTS] = { &RA, &RB, &RC } ;
+
+const pin RA0  = { &RA, 1,     PPS_GROUP1,   0, 0,         0 } ;
+const pin RA1  = { &RA, 2,     PPS_GROUP2,   0, 1,         0 } ;
+const pin RA2  = { &RA, 4,     PPS_GROUP3,   0, NO_ANALOG, 0 } ;
+const pin RA3  = { &RA, 8,     PPS_GROUP4,   0, NO_ANALOG, 0 } ;
+const pin RA4  = { &RA, 16,    PPS_GROUP3,   2, NO_ANALOG, 0 } ;
+const pin RA7  = { &RA, 128,   PPS_NO_GROUP, 0, NO_ANALOG, 0 } ;
+const pin RA8  = { &RA, 256,   PPS_GROUP2,   5, NO_ANALOG, 0 } ;
+const pin RA9  = { &RA, 512,   PPS_GROUP2,   7, NO_ANALOG, 0 } ;
+const pin RA10 = { &RA, 1024,  PPS_NO_GROUP, 0, NO_ANALOG, 0 } ;
+
+const pin RB0  = { &RB, 1,     PPS_GROUP4,   2, 2,         0 } ;
+const pin RB1  = { &RB, 2,     PPS_GROUP2,   2, 3,         0 } ;
+const pin RB2  = { &RB, 4,     PPS_GROUP3,   4, 4,         0 } ;
+const pin RB3  = { &RB, 8,     PPS_GROUP1,   1, 5,         0 } ;
+const pin RB4  = { &RB, 16,    PPS_GROUP1,   2, NO_ANALOG, 0 } ;
+const pin RB5  = { &RB, 32,    PPS_GROUP2,   1, NO_ANALOG, PIN_5V_TOLERANT } ;
+const pin RB6  = { &RB, 64,    PPS_GROUP3,   1, NO_ANALOG, PIN_5V_TOLERANT } ;
+const pin RB7  = { &RB, 128,   PPS_GROUP1,   4, NO_ANALOG, PIN_5V_TOLERANT } ;
+const pin RB8  = { &RB, 256,   PPS_GROUP2,   4, NO_ANALOG, PIN_5V_TOLERANT } ;
+const pin RB9  = { &RB, 512,   PPS_GROUP4,   4, NO_ANALOG, PIN_5V_TOLERANT } ;
+const pin RB10 = { &RB, 1024,  PPS_GROUP4,   3, NO_ANALOG, PIN_5V_TOLERANT } ;
+const pin RB11 = { &RB, 2048,  PPS_GROUP2,   3, NO_ANALOG, PIN_5V_TOLERANT } ;
+const pin RB12 = { &RB, 4096,  PPS_NO_GROUP, 0, 12,        0 } ;
+const pin RB13 = { &RB, 8192,  PPS_GROUP3,   3, 11,        0 } ;
+const pin RB14 = { &RB, 16384, PPS_GROUP4,   1, 10,        0 } ;
+const pin RB15 = { &RB, 32768, PPS_GROUP1,   3, 9,         0 } ;
+
+const pin RC0  = { &RC, 1,     PPS_GROUP1,   6, 6,         0 } ;
+const pin RC1  = { &RC, 2,     PPS_GROUP3,   6, 7,         0 } ;
+const pin RC2  = { &RC, 4,     PPS_GROUP4,   6, 8,         0 } ;
+const pin RC3  = { &RC, 8,     PPS_GROUP3,   7, NO_ANALOG, 0 } ;
+const pin RC4  = { &RC, 16,    PPS_GROUP4,   7, NO_ANALOG, 0 } ;
+const pin RC5  = { &RC, 32,    PPS_GROUP1,   7, NO_ANALOG, 0 } ;
+const pin RC6  = { &RC, 64,    PPS_GROUP3,   5, NO_ANALOG, 0 } ;
+const pin RC7  = { &RC, 128,   PPS_GROUP1,   5, NO_ANALOG, 0 } ;
+const pin RC8  = { &RC, 256,   PPS_GROUP2,   6, NO_ANALOG, 0 } ;
+const pin RC9  = { &RC, 512,   PPS_GROUP4,   5, NO_ANALOG, 0 } ;
+
+const pin *const pin_table[PIN_COUNT] = {
+    NULL,
+    &RA0, &RA1, &RA2, &RA3, &RA4, &RA7, &RA8, &RA9,
+    &RA10,
+    &RB0, &RB1, &RB2, &RB3, &RB4, &RB5, &RB6, &RB7,
+    &RB8, &RB9, &RB10, &RB11, &RB12, &RB13, &RB14, &RB15,
+    &RC0, &RC1, &RC2, &RC3, &RC4, &RC5, &RC6, &RC7,
+    &RC8, &RC9
+} ;
+
+#endif
@@ -51,6 +51,35 @@
  */
 #define ANALOGIC 1
 
+/**
+ @Summary
+    PPS groups. Pins and peripherals of the same group can be paired; pins
+    that are not remappable (RB12) belong to PPS_NO_GROUP.
+ */
+#define PPS_NO_GROUP 0
+#define PPS_GROUP1 1
+#define PPS_GROUP2 2
+#define PPS_GROUP3 3
+#define PPS_GROUP4 4
+
+/**
+ @Summary
+    Bit of PPS group <code>g</code> in the <code>groups</code> mask of a peripheral
+ */
+#define PPS_IN_GROUP(g) (1 << (g))
+
+/**
+ @Summary
+    Placeholder for the <code>analog_channel</code> field of digital-only pins
+ */
+#define NO_ANALOG (-1)
+
+/**
+ @Summary
+    Flag of the <code>flags</code> field of 5V tolerant pins (Open Drain capable)
+ */
+#define PIN_5V_TOLERANT 0x01
+
 /**
  @Summary
     The struct represents a PPS peripheral of the MCU
@@ -59,200 +88,212 @@
     PPS peripheral. Instead, each group of 5 pins is mappable to a predetermined
     set of inputs and outputs. In order not to risk to initialize a wrong peripheral
     on a pin, each peripheral is defined as a struct containing, together with its
-    code, information about its role and even the PPS register. When packet into pps
-    groups, everything becomes restricted.
+    code, information about its role, the PPS register and the mask of the PPS
+    groups it can be mapped to. The legality check is then a single bit test.
  @Remarks
+    Every descriptor of the library is declared <code>const</code> (and not
+    <code>volatile</code>): it is placed in flash and costs no RAM.
     Follows the description of every field of the struct.
     <ul>
-        <li><code>const unsigned char output_pps_code</code> :code for PPS output</li>
-        <li><code>const unsigned char io</code> : flag marker for input/output</li>
-        <li><code>const unsigned int *const *input_pps</code> : pointer to PPS input register </li>
+        <li><code>volatile unsigned int *input_pps</code> : pointer to PPS input register, NULL for outputs</li>
+        <li><code>unsigned char output_pps_code</code> : code for PPS output, NONE for inputs</li>
+        <li><code>unsigned char io</code> : flag marker for input/output</li>
+        <li><code>unsigned char groups</code> : bit n set if the peripheral belongs to PPS_GROUPn</li>
     </ul>
  */
 typedef struct{
-    const unsigned char output_pps_code;
-    const unsigned char io;
     volatile unsigned int *input_pps;
+    unsigned char output_pps_code;
+    unsigned char io;
+    unsigned char groups;
 } peripheral;
 
-typedef const volatile peripheral* pps_block[16];
+/**
+ @Summary
+    Offsets, in 32-bit words, of the IO registers from the base of a port block
+ @Description
+    On the PIC32MX1xx/2xx every port owns a 0x100 bytes block starting at ANSELx,
+    with the registers always in the same order. Each register is followed by
+    its CLR, SET and INV aliases, so <code>IO_LAT + IO_SET</code> is LATxSET.
+ */
+#define IO_ANSEL    0
+#define IO_TRIS     4
+#define IO_PORT     8
+#define IO_LAT      12
+#define IO_ODC      16
+#define IO_CNPU     20
+#define IO_CNPD     24
+#define IO_CNCON    28
+#define IO_CNEN     32
+#define IO_CNSTAT   36
+#define IO_CLR      1
+#define IO_SET      2
+#define IO_INV      3
 
 /**
   @Summary
     The struct represents an IO port of the MCU
 
   @Description
-    An IO Port struct contains pointers to any register involved in manipulation
-    of a particular IO port. In the PIC32MX model, there are many
-    registers related to the IO management, and the access to any of those is
-    necessary in order to work on IO ports at best. Every register pointer is
-    declared volatile *const, avoiding unintentional modifies of the pointer values.
+    Since every port has the same register layout, an IO Port only holds the
+    address of its register block; every register is reached through the
+    <code>IO_REG</code> macro with one of the <code>IO_*</code> offsets.
  
   @Remarks
-    Here are the specifications of every register pointer:
+    Here are the specifications of every field:
     <ul>
-        <li><code>volatile unsigned int *const *tris</code> : pointer to the TRIS register. It is responsible
-            for the Tri-State, involved in pin role switching between input and output </li>
-        <li><code>volatile unsigned int *const *lat</code> : pointer to the LAT register. This is responsible
-            for digital writes on output pins. </li>
-        <li><code>volatile unsigned int *const *port</code> : pointer to the PORT register. It is responsible
-            for the read operations. Any write operation on this register will affect
-            latches anyway.</li>
-        <li><code>volatile unsigned int *const *odc</code> : pointer to the ODC register. The Open-Drain Configuration
-            allows the user to manage a pin as open-drain, allowing it to output
-            voltages higher than the MCU Vdd when an external pull-up is correctly
-            positioned, limited to the Vih of the MCU</li>
-        <li><code>volatile unsigned int *const *cnen</code> : pointer to the CNEN register. The Change Notification
-            Enable register allows the MCU to trigger an interrupt on variation of
-            singular pins.</li>
-        <li><code>volatile unsigned int *const *cnstat</code> : pointer to the CNSTAT register. This register
-            is read-only and changes whenever a pin of the port changes its state.</li>
-        <li><code>volatile unsigned int *const *cnpu</code> : pointer to the CNPU register. Writes on this register
-            enable/disable internal weak pull-ups for MCU's pins of the port.</li>
-        <li><code>volatile unsigned int *const *cnpd</code> : pointer to the CNPD register. Writes on this register
-            enable/disable internal weak pull-down for MCU's pins of the port. </li>
-        <li><code>volatile unsigned int *const *cncon</code> : pointer to the CNCON register. </li>
-        <li><code>volatile unsigned int *const *clr</code> : pointer to the CLR register. This write-only register
-            is a shortcut for atomic pin clear operations on a port. After a write 
-            on this register, every high bit clears the associated pin </li>
-        <li><code>volatile unsigned int *const *inv</code> : pointer to INV register. This write-only register,
-            when written, inverts the state of every output pin associated with
-            high bits of the register written </li>
-        <li><code>volatile unsigned int *const *set</code> : pointer to the SET register. This write-only register
-            allows atomic bit set operations. After a write on the register, every 
-            output pin associated to high bits of the register is set high </li>
+        <li><code>volatile unsigned int *base</code> : pointer to the ANSELx register,
+            first register of the port block</li>
+        <li><code>unsigned short rp_offset</code> : offset in bytes of the RPx0R output
+            PPS register of the port from RPA0R</li>
+        <li><code>unsigned char index</code> : position of the port in <code>port_table</code>
+            (0 = RA, 1 = RB, ...), used by per-port arrays</li>
     </ul>
+    The registers of the block:
+    <ul>
+        <li><code>IO_ANSEL</code> : analog/digital selection of the pins</li>
+        <li><code>IO_TRIS</code> : the Tri-State, involved in pin role switching between
+            input and output </li>
+        <li><code>IO_LAT</code> : responsible for digital writes on output pins</li>
+        <li><code>IO_PORT</code> : responsible for the read operations. Any write operation
+            on this register will affect latches anyway.</li>
+        <li><code>IO_ODC</code> : the Open-Drain Configuration allows the user to manage a
+            pin as open-drain, allowing it to output voltages higher than the MCU Vdd
+            when an external pull-up is correctly positioned, limited to the Vih of the MCU</li>
+        <li><code>IO_CNEN</code> : the Change Notification Enable register allows the MCU
+            to trigger an interrupt on variation of singular pins.</li>
+        <li><code>IO_CNSTAT</code> : read-only, changes whenever a pin of the port changes its state.</li>
+        <li><code>IO_CNPU</code> : enables/disables internal weak pull-ups of the port.</li>
+        <li><code>IO_CNPD</code> : enables/disables internal weak pull-downs of the port.</li>
+        <li><code>IO_CNCON</code> : Change Notification control register. </li>
+    </ul>
+    <code>IO_CLR</code>, <code>IO_SET</code> and <code>IO_INV</code> added to a register offset
+    select its write-only aliases: after a write every high bit respectively clears,
+    sets or inverts the associated bit of the register, atomically.
  */
 typedef struct{
-    volatile unsigned int *tris;
-    volatile unsigned int *lat;
-    volatile unsigned int *port;
-    volatile unsigned int *odc;
-    volatile unsigned int *cnen;
-    volatile unsigned int *cnstat;
-    volatile unsigned int *cnpu;
-    volatile unsigned int *cnpd;
-    volatile unsigned int *cncon;
-    volatile unsigned int *clr;
-    volatile unsigned int *inv;
-    volatile unsigned int *set;
-}io_port;
+    volatile unsigned int *base;
+    unsigned short rp_offset;
+    unsigned char index;
+} io_port;
+
+/**
+ @Summary
+    Pointer to a register of an io_port, <code>reg</code> being an <code>IO_*</code> offset
+ @Remarks
+    Host builds on simulated registers (host/sim/xc.h) define their own.
+ */
+#ifndef IO_REG
+#define IO_REG(io, reg) ((io)->base + (reg))
+#endif
+
+/**
+ @Summary
+    Pointer to the RPxnR output PPS register of bit <code>n</code> of an
+    io_port: the registers of a port are contiguous from RPx0R
+ */
+#define IO_RP(io, n) ((volatile unsigned int*)((volatile unsigned char*)&RPA0R + (io)->rp_offset) + (n))
 
 /**
  @Summary
     The struct represents a single digital pin of the MCU.
  @Description
     In order to allow the maximum flexibility for any IO operation, every pin
-    requires a strong set of informations. Those involves IO port registers,
-    masks for pin setting, value to set on input_pps registers and pointer to
-    the output PPS register. For the PIC32MX series, Peripheral Pin Select (PPS)
+    requires a strong set of informations. Those involves its IO port, the
+    mask for pin setting, the value to set on input_pps registers and its
+    capabilities. For the PIC32MX series, Peripheral Pin Select (PPS)
     allows remapping of digital peripherals only (UART, SPI, CAN, ...).
     <b>PPS is allowed only if CFGCON<13> = 0 </b>. <br/>
         Not all peripherals can be mapped freely to all pins.
  @Remarks
     Follows the description of every field of the struct.
     <ul>
-        <li><code>volatile io_port *const *io</code> : pointer to an io_port. The io_port struct contains
-            pointers to every useful i/o register. This workaround allows the
+        <li><code>const io_port *io</code> : pointer to an io_port. This workaround allows the
             library to allocate only one io_port struct for every port and point
-            to it instead of duplicating registers on every pin struct. Delcared
-            as volatile *const, avoiding unintentional modifications and access issues.</li>
-        <li><code>const unsigned int mask</code> : this represents the mask value for
+            to it instead of duplicating registers on every pin struct.</li>
+        <li><code>unsigned short mask</code> : this represents the mask value for
             the peculiar pin. This value identifies which bit of the registers must be
             manipulated in order to work on the pin itself. </li>
-        <li><code>volatile unsigned int *const *output_pps</code> : this is a pointer
-            to the PPS Output register that must be manipulated in order to map an output
-            on this pin. </li>
-        <li><code>const pps_block *const *pps</code> : pointer to the pps_block associated </li>
+        <li><code>unsigned char pps_group</code> : the PPS group of the pin, PPS_NO_GROUP
+            if not remappable </li>
+        <li><code>unsigned char pps_input_code</code> : value to write in an input PPS
+            register to map the peripheral input on this pin </li>
+        <li><code>signed char analog_channel</code> : ANx channel of the pin, NO_ANALOG if none </li>
+        <li><code>unsigned char flags</code> : capabilities of the pin (PIN_5V_TOLERANT) </li>
     </ul>
+    The output PPS register is not stored: it is the bit-th register from
+    the RPx0R register of the port.
  */
 typedef struct{
-    const volatile io_port *io;
-    const unsigned int mask;
-    volatile unsigned int *output_pps;
-    const volatile pps_block *pps;
-    const unsigned char pps_input_code;
+    const io_port *io;
+    unsigned short mask;
+    unsigned char pps_group;
+    unsigned char pps_input_code;
+    signed char analog_channel;
+    unsigned char flags;
 } pin;
 
+/**
+ @Summary
+    Indices of the pins in <code>pin_table</code>, used to build pin_groups.
+    PIN_NONE (0) terminates a group, so the zero-filled tail of a partially
+    initialized group ends it without an explicit terminator. The PIN_RA0,
+    PIN_RA1, ... indices and PIN_COUNT come from the device tables.
+ */
+#define PIN_NONE 0
+
+/**
+ @Summary
+    Maximum number of pins in a pin_group
+ */
+#define PIN_GROUP_SIZE 16
+
 /**
  @Summary
     The struct represents an arbitrary group of pin
  @Description
-    It's used to determine peculiar groups (like 5v tolerant pins, analog pins, etc...)
+    It's an ordered list of 8-bit pin indices (PIN_RA0, ...) terminated by
+    PIN_NONE, so a full group costs 16 bytes of flash. The pin of an index is
+    <code>pin_table[index]</code>.
+ @Example
+    @code
+    const pin_group rows = { PIN_RB0, PIN_RB1, PIN_RB2 };
+ */
+typedef unsigned char pin_group[PIN_GROUP_SIZE];
+
+/**
+ @Summary
+    Number of pins of the package, selecting the device tables. Set it from
+    the project settings for the 44-pin parts.
+ @Remarks
+    The tables (device_28pin.c, device_44pin.c and their headers) are
+    generated by host/devgen from the CSV descriptions in host/devices; they
+    declare the ports RA, RB (RC), the pins RA0, RA1, ..., every PPS
+    peripheral and the capability masks of each port (RB_ANALOG_MASK, ...).
+ */
+#ifndef DEVICE_PINS
+#define DEVICE_PINS 28
+#endif
+
+#if DEVICE_PINS == 28
+#include "device_28pin.h"
+#elif DEVICE_PINS == 44
+#include "device_44pin.h"
+#else
+#error "DEVICE_PINS must be 28 or 44"
+#endif
+
+/**
+ @Summary
+    Ports by index, <code>port_table[io->index] == io</code>
+ */
+extern const io_port *const port_table[IO_PORTS];
+
+/**
+ @Summary
+    Pins by index, <code>pin_table[PIN_NONE]</code> is NULL
  */
-typedef const volatile pin* pin_group[16];
-
-
-extern const volatile io_port RA;
-extern const volatile io_port RB;
-
-extern const volatile pin RA0;
-extern const volatile pin RA1;
-extern const volatile pin RA2;
-extern const volatile pin RA3;
-extern const volatile pin RA4;
-
-extern const volatile pin RB0;
-extern const volatile pin RB1;
-extern const volatile pin RB2;
-extern const volatile pin RB3;
-extern const volatile pin RB4;
-extern const volatile pin RB5;
-extern const volatile pin RB6;
-extern const volatile pin RB7;
-extern const volatile pin RB8;
-extern const volatile pin RB9;
-extern const volatile pin RB10;
-extern const volatile pin RB11;
-extern const volatile pin RB12;
-extern const volatile pin RB13;
-extern const volatile pin RB14;
-extern const volatile pin RB15;
-
-extern const volatile peripheral INT1;
-extern const volatile peripheral INT2;
-extern const volatile peripheral INT3;
-extern const volatile peripheral INT4;
-extern const volatile peripheral T2CK;
-extern const volatile peripheral T3CK;
-extern const volatile peripheral T4CK;
-extern const volatile peripheral T5CK;
-extern const volatile peripheral IC1;
-extern const volatile peripheral IC2;
-extern const volatile peripheral IC3;
-extern const volatile peripheral IC4;
-extern const volatile peripheral IC5;
-extern const volatile peripheral OC1;
-extern const volatile peripheral OC2;
-extern const volatile peripheral OC3;
-extern const volatile peripheral OC4;
-extern const volatile peripheral OC5;
-extern const volatile peripheral REFCLKI;
-extern const volatile peripheral REFCLKO;
-extern const volatile peripheral U1CTS;
-extern const volatile peripheral U1RTS;
-extern const volatile peripheral U1RX;
-extern const volatile peripheral U1TX;
-extern const volatile peripheral U2CTS;
-extern const volatile peripheral U2RTS;
-extern const volatile peripheral U2RX;
-extern const volatile peripheral U2TX;
-extern const volatile peripheral SDI1;
-extern const volatile peripheral SDO1;
-extern const volatile peripheral SS1;
-extern const volatile peripheral SDI2;
-extern const volatile peripheral SDO2;
-extern const volatile peripheral SS2;
-extern const volatile peripheral OCFA;
-extern const volatile peripheral OCFB;
-extern const volatile peripheral C1OUT;
-extern const volatile peripheral C2OUT;
-extern const volatile peripheral C3OUT;
-
-extern const volatile pps_block GROUP1;
-extern const volatile pps_block GROUP2;
-extern const volatile pps_block GROUP3;
-extern const volatile pps_block GROUP4;
+extern const pin *const pin_table[PIN_COUNT];
 
 /**
 @Function
@@ -279,7 +320,7 @@ extern const volatile pps_block GROUP4;
     pin_set_direction(&RB4, INPUT); //sets RB4 pin as input (TRISB<5> = 1)
     pin_set_direction(&RA3, OUTPUT); //sets RA3 pin as output (TRISA<4> = 0)
 */
-extern inline void pin_set_direction(const volatile pin *p, unsigned char direction);
+extern inline void pin_set_direction(const pin *p, unsigned char direction);
 
 /**
 @Function
@@ -310,7 +351,7 @@ extern inline void pin_set_direction(const volatile pin *p, unsigned char direct
     pin_set_output_state(&RB4, HIGH); //sets RB4 pin high (LATB<5> = 1)
     pin_set_output_state(&RA3, LOW); //sets RA3 pin low (LATA<4> = 0)
 */
-extern inline void pin_set_output_state(const volatile pin *p, unsigned char value);
+extern inline void pin_set_output_state(const pin *p, unsigned char value);
 
 /**
 @Function
@@ -335,7 +376,7 @@ extern inline void pin_set_output_state(const volatile pin *p, unsigned char val
     @code
     pin_set_output_high(&RB3); //drives RB3 HIGH (LATB<4> = 1)
 */
-extern inline void pin_set_output_high(const volatile pin *p);
+extern inline void pin_set_output_high(const pin *p);
 
 /**
 @Function
@@ -360,7 +401,7 @@ extern inline void pin_set_output_high(const volatile pin *p);
     @code
     pin_set_output_low(&RB3); //drives RB3 LOW (LATB<4> = 0)
 */
-extern inline void pin_set_output_low(const volatile pin *p);
+extern inline void pin_set_output_low(const pin *p);
 
 /**
 @Function
@@ -386,7 +427,7 @@ extern inline void pin_set_output_low(const volatile pin *p);
     pin_set_output_high(&RB3); //drives RB3 HIGH (LATB<4> = 1)
     pin_invert(&RB3);          //inverts RB3 to LOW (LATBINV<4> = 1)
 */
-extern inline void pin_invert(const volatile pin *p);
+extern inline void pin_invert(const pin *p);
 
 /**
 @Function
@@ -412,7 +453,7 @@ extern inline void pin_invert(const volatile pin *p);
     pin_set_output_high(&RB3); //drives RB3 HIGH (LATB<4> = 1)
     pin_invert(&RB3);          //inverts RB3 to LOW (LATBINV<4> = 1)
 */
-extern inline unsigned char pin_read(const volatile pin *p);
+extern inline unsigned char pin_read(const pin *p);
 
 /**
 @Function
@@ -457,7 +498,7 @@ extern inline unsigned char pin_read(const volatile pin *p);
     pin_assign_peripheral(&RB3, &REFCLKI); //assigns REFCLKI peripheral to RB3, returns 1
     pin_assign_peripheral(&RB4, &INT3);    //fails the assignment due to illegal pairing, returns 0
 */
-extern unsigned char pin_assign_peripheral(const volatile pin *p, const volatile peripheral *peripheral);
+extern unsigned char pin_assign_peripheral(const pin *p, const peripheral *peripheral);
 
 /**
 @Function
@@ -485,7 +526,8 @@ extern unsigned char pin_assign_peripheral(const volatile pin *p, const volatile
     <li><code>0</code> if the assignment is not legal and no operation has been done </li>
 </ul>
 @Remarks
-    Only a couple of pins are 5V-tolerant, precisely from RB5 to RB11 
+    Only a couple of pins are 5V-tolerant, precisely from RB5 to RB11 (flag
+    PIN_5V_TOLERANT of the pin)
  
 @Example
     @code
@@ -493,7 +535,7 @@ extern unsigned char pin_assign_peripheral(const volatile pin *p, const volatile
     pin_open_drain_selection(&RB7, OFF);//set RB4 as digital, returns 1
     pin_open_drain_selection(&RA0, OFF);//does nothing and returns 0 (pin not 5V-tolerant)
 */
-extern inline unsigned char pin_open_drain_selection(const volatile pin *p, unsigned char request);
+extern inline unsigned char pin_open_drain_selection(const pin *p, unsigned char request);
 
 /**
 @Function
@@ -525,7 +567,7 @@ extern inline unsigned char pin_open_drain_selection(const volatile pin *p, unsi
     <ul>
         <li>RA0, RA1 as AN0, AN1</li>
         <li>RB0 to RB3 as AN2 to AN5</li>
-        <li>RB12, RB13 as AN12, AN11</li>
+        <li>RB12, RB13, RB14 as AN12, AN11, AN10</li>
         <li>RB15 as AN9</li>
     </ul>
  
@@ -535,7 +577,7 @@ extern inline unsigned char pin_open_drain_selection(const volatile pin *p, unsi
     pin_select_working_mode(&RB3, DIGITAL);//set RB3 as digital, returns 1
     pin_select_working_mode(&RA2, DIGITAL);//does nothing, return 0
 */
-extern inline unsigned char pin_select_working_mode(const volatile pin *p, unsigned char analog_digital);
+extern inline unsigned char pin_select_working_mode(const pin *p, unsigned char analog_digital);
 
 /**
 @Function
@@ -565,7 +607,7 @@ extern inline unsigned char pin_select_working_mode(const volatile pin *p, unsig
     pin_assign_interrupt_on_change(&RB3, ON);  //set Interrupt on change on RB3
     
 */
-extern inline void pin_assign_interrupt_on_change(const volatile pin *p, unsigned char activated);
+extern inline void pin_assign_interrupt_on_change(const pin *p, unsigned char activated);
 
 /**
 @Function
@@ -594,7 +636,7 @@ extern inline void pin_assign_interrupt_on_change(const volatile pin *p, unsigne
     pin_assign_pull_up(&RA0, ON); //activates internal pull-up on RA0
     pin_assign_pull_up(&RB3, OFF);//deactivates internal pull-up on RB3
 */
-extern inline void pin_assign_pull_up(const volatile pin *p, unsigned char activated);
+extern inline void pin_assign_pull_up(const pin *p, unsigned char activated);
 
 /**
 @Function
@@ -623,7 +665,7 @@ extern inline void pin_assign_pull_up(const volatile pin *p, unsigned char activ
     pin_assign_pull_down(&RA0, ON); //activates internal pull-down on RA0
     pin_assign_pull_down(&RB3, OFF);//deactivates internal pull-down on RB3
 */
-extern inline void pin_assign_pull_down(const volatile pin *p, unsigned char activated);
+extern inline void pin_assign_pull_down(const pin *p, unsigned char activated);
 
 /**
 @Function
@@ -647,7 +689,7 @@ extern inline void pin_assign_pull_down(const volatile pin *p, unsigned char act
     @code
     port_set_direction(&RA, 0b11111); //sets entire Port A as Input
 */
-extern inline void port_set_direction(const volatile io_port *p, unsigned int mask);
+extern inline void port_set_direction(const io_port *p, unsigned int mask);
 
 /**
 @Function
@@ -671,7 +713,7 @@ extern inline void port_set_direction(const volatile io_port *p, unsigned int ma
     @code
     port_set_output_state(&RA, 0b11111); //sets entire Port A output as HIGH
 */
-extern inline void port_set_output_state(const volatile io_port *p, unsigned int mask);
+extern inline void port_set_output_state(const io_port *p, unsigned int mask);
 
 /**
 @Function
@@ -695,7 +737,7 @@ extern inline void port_set_output_state(const volatile io_port *p, unsigned int
     @code
     port_invert(&RA, 0b11111); //inverts entire Port A output as HIGH
 */
-extern inline void port_invert(const volatile io_port *p, unsigned char mask);
+extern inline void port_invert(const io_port *p, unsigned int mask);
 
 /**
 @Function
@@ -706,7 +748,7 @@ extern inline void port_invert(const volatile io_port *p, unsigned char mask);
     IO ports.
 
 @Description
-    The function works as proxy for the CNSTATx assignment, but it makes the code
+    The function works as proxy for the CNCONx assignment, but it makes the code
     easier to understand
 
 @Precondition
@@ -721,6 +763,6 @@ extern inline void port_invert(const volatile io_port *p, unsigned char mask);
     @code
     port_set_change_notice_behaviour(&RA, ON, OFF); //sets the Int. on change ON but OFF in idle
 */
-extern void port_set_change_notice_behaviour(const volatile io_port *p, unsigned char active, unsigned char idle_state);
+extern void port_set_change_notice_behaviour(const io_port *p, unsigned char active, unsigned char idle_state);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include <xc.h>
+#include "encoder.h"
+
+/* Index is (old_state << 2) | new_state, phase A on bit 1, phase B on bit 0 */
+static const signed char table_x4[16] = {
+     0, +1, -1,  0,
+    -1,  0,  0, +1,
+    +1,  0,  0, -1,
+     0, -1, +1,  0
+};
+static const signed char table_x2[16] = {
+     0,  0, -1,  0,
+     0,  0,  0, +1,
+    +1,  0,  0,  0,
+     0, -1,  0,  0
+};
+static const signed char table_x1[16] = {
+     0,  0,  0,  0,
+     0,  0,  0, +1,
+     0,  0,  0,  0,
+     0, -1,  0,  0
+};
+/* Transitions where both phases changed: 00<->11 and 01<->10 */
+#define ILLEGAL_TRANSITIONS ((1 << 3) | (1 << 6) | (1 << 9) | (1 << 12))
+
+static encoder *encoders[ENCODER_MAX];
+static unsigned char encoders_count = 0;
+static unsigned char ports_used = 0; /* bit 0 = RA, bit 1 = RB */
+
+static unsigned char mask_to_shift(unsigned int mask){
+    unsigned char i = 0;
+    while(mask > 1){
+        mask >>= 1;
+        i++;
+    }
+    return i;
+}
+
+unsigned char encoder_init(encoder *e, const pin *a, const pin *b, unsigned char mode){
+    unsigned int word;
+    if(a->io != b->io) return 0;
+    if(encoders_count == ENCODER_MAX) return 0;
+    if(mode == ENCODER_X4) e->table = table_x4;
+    else if(mode == ENCODER_X2) e->table = table_x2;
+    else if(mode == ENCODER_X1) e->table = table_x1;
+    else return 0;
+
+    pin_set_direction(a, INPUT);
+    pin_set_direction(b, INPUT);
+    pin_select_working_mode(a, DIGITAL);
+    pin_select_working_mode(b, DIGITAL);
+
+    e->port = a->io->index;
+    e->shift_a = mask_to_shift(a->mask);
+    e->shift_b = mask_to_shift(b->mask);
+    word = *IO_REG(a->io, IO_PORT);
+    e->state = (((word >> e->shift_a) & 1) << 1) | ((word >> e->shift_b) & 1);
+    e->position = 0;
+    e->velocity = 0;
+    e->errors = 0;
+    e->last_position = 0;
+
+    pin_assign_interrupt_on_change(a, ON);
+    pin_assign_interrupt_on_change(b, ON);
+    ports_used |= 1 << e->port;
+    encoders[encoders_count++] = e;
+    return 1;
+}
+
+unsigned char encoder_start(void){
+    unsigned char i, p;
+    encoder *e;
+    if(!interrupt_attach(&CN_B, encoder_change_notice_handler)){
+        /* Another module owns the vector: its handler would not read our pins */
+        for(i = 0; i < encoders_count; i++){
+            e = encoders[i];
+            *IO_REG(port_table[e->port], IO_CNEN + IO_CLR) = (1 << e->shift_a) | (1 << e->shift_b);
+        }
+        return 0;
+    }
+    for(p = 0; p < IO_PORTS; p++)
+        if(ports_used & (1 << p)){
+            port_set_change_notice_behaviour(port_table[p], ON, ON);
+            interrupt_configure(change_notice[p], CN_INTERRUPT_PRIORITY, 0);
+        }
+    for(p = 0; p < IO_PORTS; p++)
+        if(ports_used & (1 << p)) interrupt_enable(change_notice[p], ON);
+    return 1;
+}
+
+void encoder_change_notice_handler(void){
+    unsigned int words[IO_PORTS];
+    unsigned char i, next, transition;
+    encoder *e;
+
+    /* Reading PORTx also clears the mismatch condition of the port */
+    if(ports_used & 1) words[0] = PORTA;
+    if(ports_used & 2) words[1] = PORTB;
+#if IO_PORTS > 2
+    if(ports_used & 4) words[2] = PORTC;
+#endif
+
+    for(i = 0; i < encoders_count; i++){
+        e = encoders[i];
+        next = (((words[e->port] >> e->shift_a) & 1) << 1) | ((words[e->port] >> e->shift_b) & 1);
+        transition = (e->state << 2) | next;
+        e->position += e->table[transition];
+        e->errors += (ILLEGAL_TRANSITIONS >> transition) & 1;
+        e->state = next;
+    }
+}
+
+void encoder_velocity_tick(void){
+    unsigned char i;
+    int position;
+    for(i = 0; i < encoders_count; i++){
+        position = encoders[i]->position;
+        encoders[i]->velocity = position - encoders[i]->last_position;
+        encoders[i]->last_position = position;
+    }
+}
+
+inline int encoder_position(const encoder *e){
+    return e->position;
+}
+
+void encoder_set_position(encoder *e, int position){
+    const interrupt_source *src = change_notice[e->port];
+    interrupt_enable(src, OFF);
+    e->position = position;
+    e->last_position = position;
+    *(src->iec_set) = src->mask; /* Keep a pending edge: do not clear the flag */
+}
+
+inline int encoder_velocity(const encoder *e){
+    return e->velocity;
+}
+
+inline unsigned int encoder_errors(const encoder *e){
+    return e->errors;
+}
@@ -0,0 +1,192 @@
+#ifndef _ENCODER_H
+#define _ENCODER_H
+
+#include "digital_io.h"
+#include "interrupts.h"
+
+/**
+ @Summary
+    Maximum number of encoders served by the Change Notification handler
+ */
+#ifndef ENCODER_MAX
+#define ENCODER_MAX 4
+#endif
+
+/**
+ @Summary
+    Decoding resolution: one count per cycle of phase A (X1), per edge of
+    phase A (X2) or per edge of any phase (X4)
+ */
+#define ENCODER_X1 1
+#define ENCODER_X2 2
+#define ENCODER_X4 4
+
+/**
+ @Summary
+    The struct represents a quadrature encoder read on two pins
+ @Description
+    The struct is allocated by the user and filled by <code>encoder_init</code>.
+    The Change Notification handler reads every used port once, extracts both
+    phases with the precomputed shifts and looks up the transition in a
+    16-entry table indexed by <code>(old_state << 2) | new_state</code>.
+ @Remarks
+    <code>position</code>, <code>velocity</code> and <code>errors</code> are
+    32-bit words updated by the handler only: a plain read is atomic on the
+    PIC32, so they can be read from the main loop without disabling interrupts.
+    Use <code>encoder_position</code>, <code>encoder_velocity</code> and
+    <code>encoder_errors</code> rather than touching the fields.
+    <ul>
+        <li><code>const signed char *table</code> : transition table of the selected mode</li>
+        <li><code>unsigned char port</code> : index of the port read (<code>io_port.index</code>: 0 = RA, 1 = RB, 2 = RC)</li>
+        <li><code>unsigned char shift_a</code> : bit position of phase A in PORTx</li>
+        <li><code>unsigned char shift_b</code> : bit position of phase B in PORTx</li>
+        <li><code>unsigned char state</code> : last sampled state, phase A on bit 1</li>
+        <li><code>volatile int position</code> : position in counts</li>
+        <li><code>volatile int velocity</code> : counts between the last two velocity ticks</li>
+        <li><code>volatile unsigned int errors</code> : illegal transitions (both phases changed)</li>
+        <li><code>int last_position</code> : position at the last velocity tick</li>
+    </ul>
+ */
+typedef struct{
+    const signed char *table;
+    unsigned char port;
+    unsigned char shift_a;
+    unsigned char shift_b;
+    unsigned char state;
+    volatile int position;
+    volatile int velocity;
+    volatile unsigned int errors;
+    int last_position;
+} encoder;
+
+/**
+@Function
+    unsigned char encoder_init(encoder *e, const pin *a, const pin *b, unsigned char mode)
+
+@Summary
+    The function registers a quadrature encoder on the given pins.
+
+@Description
+    Both pins are set as INPUT and DIGITAL, with Interrupt On Change active.
+    The initial state is sampled, so the first edge is decoded correctly.
+
+@Precondition
+    None. Call <code>encoder_start</code> once every encoder is registered.
+
+@Parameters
+    @param e the encoder struct to fill
+    @param a pin wired to phase A
+    @param b pin wired to phase B, on the same port of <code>a</code>
+    @param mode ENCODER_X1, ENCODER_X2 or ENCODER_X4
+
+@Returns
+<ul>
+    <li><code>1</code> if the encoder has been registered</li>
+    <li><code>0</code> if the pins are on different ports, the mode is unknown
+        or ENCODER_MAX encoders are already registered</li>
+</ul>
+
+@Example
+    @code
+    encoder knob;
+    encoder_init(&knob, &RB4, &RB5, ENCODER_X4);
+    encoder_start();
+*/
+extern unsigned char encoder_init(encoder *e, const pin *a, const pin *b, unsigned char mode);
+
+/**
+@Function
+    unsigned char encoder_start(void)
+
+@Summary
+    The function attaches the encoder handler to the Change Notification vector
+    and turns the Change Notification ON for the ports in use.
+
+@Returns
+<ul>
+    <li><code>1</code> if the encoders are running</li>
+    <li><code>0</code> if another handler owns the Change Notification vector;
+        Interrupt On Change is then turned OFF on the encoder pins</li>
+</ul>
+
+@Remarks
+    Call <code>interrupt_init</code> afterwards if not already done. If other
+    modules need the Change Notification vector, attach a function calling
+    <code>encoder_change_notice_handler</code> instead.
+*/
+extern unsigned char encoder_start(void);
+
+/**
+@Function
+    void encoder_change_notice_handler(void)
+
+@Summary
+    Change Notification handler decoding every registered encoder.
+
+@Description
+    One PORTx read per used port, then for every encoder two shifts, one table
+    lookup and one add. Illegal transitions are counted with a 16-bit mask test
+    and do not move the position.
+*/
+extern void encoder_change_notice_handler(void);
+
+/**
+@Function
+    void encoder_velocity_tick(void)
+
+@Summary
+    The function samples the velocity of every registered encoder.
+
+@Description
+    Meant to be attached to a timer vector: the velocity is expressed in counts
+    per timer period.
+
+@Example
+    @code
+    interrupt_attach(&TIMER2, encoder_velocity_tick);
+*/
+extern void encoder_velocity_tick(void);
+
+/**
+@Function
+    inline int encoder_position(const encoder *e)
+
+@Summary
+    The function returns the position of the encoder, in counts. Lock-free.
+*/
+extern inline int encoder_position(const encoder *e);
+
+/**
+@Function
+    void encoder_set_position(encoder *e, int position)
+
+@Summary
+    The function overwrites the position of the encoder.
+
+@Remarks
+    The Change Notification source is masked around the write, since the
+    handler does a read-modify-write of the same word.
+*/
+extern void encoder_set_position(encoder *e, int position);
+
+/**
+@Function
+    inline int encoder_velocity(const encoder *e)
+
+@Summary
+    The function returns the counts sampled between the last two calls of
+    <code>encoder_velocity_tick</code>. Lock-free.
+*/
+extern inline int encoder_velocity(const encoder *e);
+
+/**
+@Function
+    inline unsigned int encoder_errors(const encoder *e)
+
+@Summary
+    The function returns the number of illegal transitions seen so far. A
+    growing value means the shaft spins faster than the handler can follow.
+*/
+extern inline unsigned int encoder_errors(const encoder *e);
+
+#endif
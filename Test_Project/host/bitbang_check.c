@@ -0,0 +1,78 @@
+/*
+ * Timing check of the bit-bang engines (bitbang.c) on the simulated SFRs of
+ * host/sim, whose Core Timer runs from the host monotonic clock. It runs
+ * ws2812_measure, onewire_measure and i2c_bb_measure, prints every measured
+ * phase against the WS2812B, 1-Wire standard speed and I2C windows, and
+ * checks that an I2C slave holding SCL LOW ends the transfer with
+ * I2C_BB_TIMEOUT and both lines released. 'make SHELL=sh bitbang' runs it at
+ * 100 and 400 kHz; by hand, from the project directory:
+ *
+ *     cc -std=gnu99 -fgnu89-inline -O2 -DI2C_BB_FREQ=100000 -Ihost/sim -I. -o bitbang_check \
+ *        host/bitbang_check.c bitbang.c digital_io.c device_28pin.c host/sim/sim.c
+ *
+ * The host is not real time: a measure out of its window is run again, up
+ * to CHECK_RUNS times, before it counts as a failure. On the device the
+ * same *_measure functions give the figures of the board.
+ */
+#include <stdio.h>
+#include <xc.h>
+#include "bitbang.h"
+
+#define CHECK_RUNS 5
+
+typedef unsigned char (*measure_function)(bitbang_timing *report);
+
+static const char *const ws2812_names[WS2812_TIMINGS] = { "T0H", "T1H", "T0L", "T1L" };
+static const char *const onewire_names[ONEWIRE_TIMINGS] = { "write 0 LOW", "write 1 LOW", "read sample", "slot" };
+static const char *const i2c_names[I2C_BB_TIMINGS] = { "tLOW", "tHIGH" };
+
+static unsigned int failures;
+
+static void print_window(unsigned int ns){
+    if(ns == 0xFFFFFFFF) printf("%9s", "-");
+    else printf("%9u", ns);
+}
+
+static void check(const char *engine, measure_function measure, const char *const *names, unsigned char count){
+    bitbang_timing report[4];
+    unsigned char i, run, ok = 0;
+    for(run = 0; run < CHECK_RUNS && !ok; run++) ok = measure(report);
+    printf("%s%s\n", engine, ok ? "" : ": OUT OF SPEC");
+    printf("    %-14s %9s %9s %9s %9s  (ns)\n", "phase", "spec min", "spec max", "min", "max");
+    for(i = 0; i < count; i++){
+        printf("    %-14s", names[i]);
+        print_window(report[i].spec_min_ns);
+        print_window(report[i].spec_max_ns);
+        printf(" %9u %9u\n", report[i].min_ns, report[i].max_ns);
+    }
+    if(!ok) failures++;
+}
+
+static void check_stretch_timeout(void){
+    unsigned char data = 0, result, lines;
+    sim_drive(1, 1u << I2C_BB_SCL_BIT, 0);
+    result = i2c_bb_write(0x50, &data, 1);
+    lines = (TRISB >> I2C_BB_SCL_BIT & 1) && (TRISB >> I2C_BB_SDA_BIT & 1);
+    sim_drive(1, 1u << I2C_BB_SCL_BIT, 1u << I2C_BB_SCL_BIT);
+    printf("i2c, SCL held LOW: %s\n", result == I2C_BB_TIMEOUT && lines ? "timeout, lines released" : "NOT DETECTED");
+    if(result != I2C_BB_TIMEOUT || !lines) failures++;
+}
+
+int main(void){
+    sim_enable_interrupts();
+    /* The external pull-ups of the open-drain lines */
+    sim_drive(1, (1u << ONEWIRE_BIT) | (1u << I2C_BB_SCL_BIT) | (1u << I2C_BB_SDA_BIT),
+                 (1u << ONEWIRE_BIT) | (1u << I2C_BB_SCL_BIT) | (1u << I2C_BB_SDA_BIT));
+    ws2812_init();
+    onewire_init();
+    i2c_bb_init();
+
+    check("ws2812", ws2812_measure, ws2812_names, WS2812_TIMINGS);
+    check("1-wire", onewire_measure, onewire_names, ONEWIRE_TIMINGS);
+    printf("i2c at %lu Hz, ", (unsigned long)I2C_BB_FREQ);
+    check("SCL", i2c_bb_measure, i2c_names, I2C_BB_TIMINGS);
+    check_stretch_timeout();
+
+    printf("bit-bang timing: %u failed\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,298 @@
+/*
+ * Device table generator. Reads the pin/PPS/analog description of a package
+ * (host/devices/<package>.csv) and writes the port, pin, peripheral and pin_table
+ * definitions used by digital_io.c, in the same layout as the hand-written
+ * 28-pin tables. Build and run on the host:
+ *
+ *     cc -O2 -o devgen devgen.c
+ *     ./devgen devices/pic32mx1xx_28pin.csv ../device_28pin
+ *
+ * which writes ../device_28pin.h and ../device_28pin.c. The CSV records are
+ *
+ *     device,<DEVICE_PINS value>,<description without commas>
+ *     port,<name>,<ANSEL register>,<RPx0R offset from RPA0R>
+ *     pin,<name>,<port>,<bit>,<PPS group|->,<PPS input code>,<ANx|->,<5V|->
+ *     peripheral,<name>,<input PPS register|->,<output PPS code|->,<groups>
+ *
+ * with <groups> a space separated list of PPS groups. Lines starting with #
+ * are comments.
+ */
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PORTS 8
+#define MAX_PINS 128
+#define MAX_PERIPHERALS 64
+#define MAX_FIELDS 8
+
+typedef struct{
+    char name[8];
+    char ansel[16];
+    unsigned int rp_offset;
+    unsigned int pins, analog, tolerant, remappable;
+} port_desc;
+
+typedef struct{
+    char name[8];
+    int port;
+    int bit;
+    int group;
+    int input_code;
+    int analog;
+    int tolerant;
+} pin_desc;
+
+typedef struct{
+    char name[12];
+    char input[16];
+    int output_code;
+    unsigned int groups;
+} peripheral_desc;
+
+static port_desc ports[MAX_PORTS];
+static pin_desc pins[MAX_PINS];
+static peripheral_desc peripherals[MAX_PERIPHERALS];
+static int ports_count, pins_count, peripherals_count;
+static int device_pins;
+static char description[128];
+static const char *source;
+static int line;
+
+static void fail(const char *message){
+    fprintf(stderr, "%s:%d: %s\n", source, line, message);
+    exit(1);
+}
+
+static char *trim(char *s){
+    char *end;
+    while(isspace((unsigned char)*s)) s++;
+    end = s + strlen(s);
+    while(end > s && isspace((unsigned char)end[-1])) *--end = 0;
+    return s;
+}
+
+static int split(char *s, char **fields){
+    int i, n = 0;
+    char *comma;
+    while(n < MAX_FIELDS){
+        fields[n++] = s;
+        comma = strchr(s, ',');
+        if(comma == NULL) break;
+        *comma = 0;
+        s = comma + 1;
+    }
+    for(i = 0; i < n; i++) fields[i] = trim(fields[i]);
+    return n;
+}
+
+static int number_or_none(const char *s, int none){
+    char *end;
+    long v;
+    if(strcmp(s, "-") == 0) return none;
+    v = strtol(s, &end, 0);
+    if(*s == 0 || *end != 0) fail("expected a number or -");
+    return (int)v;
+}
+
+static void copy(char *dst, const char *src, size_t size){
+    if(strlen(src) >= size) fail("name too long");
+    strcpy(dst, src);
+}
+
+static int find_port(const char *name){
+    int i;
+    for(i = 0; i < ports_count; i++)
+        if(strcmp(ports[i].name, name) == 0) return i;
+    fail("unknown port");
+    return -1;
+}
+
+static void parse(FILE *f){
+    char buffer[256], *s, *fields[MAX_FIELDS], *group;
+    int n;
+    while(fgets(buffer, sizeof(buffer), f) != NULL){
+        line++;
+        s = trim(buffer);
+        if(*s == 0 || *s == '#') continue;
+        n = split(s, fields);
+        if(strcmp(fields[0], "device") == 0 && n == 3){
+            device_pins = number_or_none(fields[1], 0);
+            copy(description, fields[2], sizeof(description));
+        }
+        else if(strcmp(fields[0], "port") == 0 && n == 4){
+            port_desc *p = &ports[ports_count];
+            if(ports_count == MAX_PORTS) fail("too many ports");
+            if(pins_count != 0) fail("ports must precede pins");
+            copy(p->name, fields[1], sizeof(p->name));
+            copy(p->ansel, fields[2], sizeof(p->ansel));
+            p->rp_offset = number_or_none(fields[3], 0);
+            ports_count++;
+        }
+        else if(strcmp(fields[0], "pin") == 0 && n == 8){
+            pin_desc *p = &pins[pins_count];
+            if(pins_count == MAX_PINS) fail("too many pins");
+            copy(p->name, fields[1], sizeof(p->name));
+            p->port = find_port(fields[2]);
+            p->bit = number_or_none(fields[3], -1);
+            p->group = number_or_none(fields[4], 0);
+            p->input_code = number_or_none(fields[5], 0);
+            p->analog = number_or_none(fields[6], -1);
+            p->tolerant = strcmp(fields[7], "5V") == 0;
+            if(p->bit < 0 || p->bit > 15) fail("bit out of range");
+            if(p->group < 0 || p->group > 4) fail("PPS group out of range");
+            if(pins_count > 0 && p->port < pins[pins_count - 1].port) fail("pins must be sorted by port");
+            if(ports[p->port].pins & (1u << p->bit)) fail("duplicate pin");
+            ports[p->port].pins |= 1u << p->bit;
+            if(p->analog >= 0) ports[p->port].analog |= 1u << p->bit;
+            if(p->tolerant) ports[p->port].tolerant |= 1u << p->bit;
+            if(p->group) ports[p->port].remappable |= 1u << p->bit;
+            pins_count++;
+        }
+        else if(strcmp(fields[0], "peripheral") == 0 && n == 5){
+            peripheral_desc *p = &peripherals[peripherals_count];
+            if(peripherals_count == MAX_PERIPHERALS) fail("too many peripherals");
+            copy(p->name, fields[1], sizeof(p->name));
+            copy(p->input, fields[2], sizeof(p->input));
+            p->output_code = number_or_none(fields[3], -1);
+            if((strcmp(p->input, "-") == 0) == (p->output_code < 0)) fail("a peripheral is either an input or an output");
+            p->groups = 0;
+            for(group = strtok(fields[4], " "); group != NULL; group = strtok(NULL, " ")){
+                n = number_or_none(group, 0);
+                if(n < 1 || n > 4) fail("PPS group out of range");
+                p->groups |= 1u << n;
+            }
+            if(p->groups == 0) fail("peripheral without PPS groups");
+            peripherals_count++;
+        }
+        else fail("malformed record");
+    }
+    if(device_pins == 0 || ports_count == 0 || pins_count == 0) fail("device, port and pin records are required");
+}
+
+static const char *base_name(const char *path){
+    const char *slash = strrchr(path, '/');
+    return slash == NULL ? path : slash + 1;
+}
+
+static FILE *create(const char *prefix, const char *extension){
+    char path[512];
+    FILE *f;
+    snprintf(path, sizeof(path), "%s%s", prefix, extension);
+    f = fopen(path, "w");
+    if(f == NULL){
+        perror(path);
+        exit(1);
+    }
+    return f;
+}
+
+static void write_header(const char *prefix){
+    FILE *f = create(prefix, ".h");
+    char guard[128];
+    const char *name = base_name(prefix);
+    int i;
+    for(i = 0; name[i] && i < (int)sizeof(guard) - 4; i++) guard[i] = toupper((unsigned char)name[i]);
+    guard[i] = 0;
+
+    fprintf(f, "/* Generated by host/devgen from %s, do not edit */\n", base_name(source));
+    fprintf(f, "#ifndef _%s_H\n#define _%s_H\n\n", guard, guard);
+    fprintf(f, "/*\n * %s\n */\n\n", description);
+    fprintf(f, "#define IO_PORTS %d\n\n", ports_count);
+    for(i = 0; i < pins_count; i++)
+        fprintf(f, "#define PIN_%-4s %d\n", pins[i].name, i + 1);
+    fprintf(f, "#define PIN_COUNT %d\n\n", pins_count + 1);
+    fprintf(f, "/* Capabilities of the pins of each port */\n");
+    for(i = 0; i < ports_count; i++){
+        fprintf(f, "#define %s_PIN_MASK          0x%04X\n", ports[i].name, ports[i].pins);
+        fprintf(f, "#define %s_ANALOG_MASK       0x%04X\n", ports[i].name, ports[i].analog);
+        fprintf(f, "#define %s_5V_TOLERANT_MASK  0x%04X\n", ports[i].name, ports[i].tolerant);
+        fprintf(f, "#define %s_REMAPPABLE_MASK   0x%04X\n", ports[i].name, ports[i].remappable);
+    }
+    fprintf(f, "\n");
+    for(i = 0; i < ports_count; i++) fprintf(f, "extern const io_port %s;\n", ports[i].name);
+    for(i = 0; i < pins_count; i++){
+        if(i > 0 && pins[i].port != pins[i - 1].port) fprintf(f, "\n");
+        else if(i == 0) fprintf(f, "\n");
+        fprintf(f, "extern const pin %s;\n", pins[i].name);
+    }
+    fprintf(f, "\n");
+    for(i = 0; i < peripherals_count; i++) fprintf(f, "extern const peripheral %s;\n", peripherals[i].name);
+    fprintf(f, "\n#endif\n");
+    fclose(f);
+}
+
+static void write_source(const char *prefix){
+    FILE *f = create(prefix, ".c");
+    char field[64], groups[128];
+    int i, g, n;
+
+    fprintf(f, "/* Generated by host/devgen from %s, do not edit */\n", base_name(source));
+    fprintf(f, "#include <xc.h>\n#include \"digital_io.h\"\n\n");
+    fprintf(f, "#if DEVICE_PINS == %d\n\n", device_pins);
+
+    for(i = 0; i < peripherals_count; i++){
+        peripheral_desc *p = &peripherals[i];
+        groups[0] = 0;
+        for(g = 1; g <= 4; g++)
+            if(p->groups & (1u << g)){
+                if(groups[0]) strcat(groups, " | ");
+                n = strlen(groups);
+                snprintf(groups + n, sizeof(groups) - n, "PPS_IN_GROUP(PPS_GROUP%d)", g);
+            }
+        snprintf(field, sizeof(field), "%s =", p->name);
+        if(p->output_code < 0) fprintf(f, "const peripheral %-11s{ &%s, NONE, INPUT, %s } ;\n", field, p->input, groups);
+        else fprintf(f, "const peripheral %-11s{ NULL, %d, OUTPUT, %s } ;\n", field, p->output_code, groups);
+    }
+    fprintf(f, "\n");
+
+    for(i = 0; i < ports_count; i++)
+        fprintf(f, "const io_port %s = { &%s, 0x%02X, %d } ;\n", ports[i].name, ports[i].ansel, ports[i].rp_offset, i);
+    fprintf(f, "\nconst io_port *const port_table[IO_PORTS] = { ");
+    for(i = 0; i < ports_count; i++) fprintf(f, "%s&%s", i ? ", " : "", ports[i].name);
+    fprintf(f, " } ;\n");
+
+    for(i = 0; i < pins_count; i++){
+        pin_desc *p = &pins[i];
+        char mask[16], group[16], analog[16];
+        if(i == 0 || p->port != pins[i - 1].port) fprintf(f, "\n");
+        snprintf(mask, sizeof(mask), "%u,", 1u << p->bit);
+        if(p->group) snprintf(group, sizeof(group), "PPS_GROUP%d,", p->group);
+        else strcpy(group, "PPS_NO_GROUP,");
+        if(p->analog >= 0) snprintf(analog, sizeof(analog), "%d,", p->analog);
+        else strcpy(analog, "NO_ANALOG,");
+        fprintf(f, "const pin %-4s = { &%s, %-6s %-13s %d, %-10s %s } ;\n", p->name, ports[p->port].name,
+                mask, group, p->input_code, analog, p->tolerant ? "PIN_5V_TOLERANT" : "0");
+    }
+
+    fprintf(f, "\nconst pin *const pin_table[PIN_COUNT] = {\n    NULL");
+    for(i = 0, n = 0; i < pins_count; i++, n++){
+        if(i == 0 || pins[i].port != pins[i - 1].port || n == 8){
+            fprintf(f, ",\n    &%s", pins[i].name);
+            n = 0;
+        }
+        else fprintf(f, ", &%s", pins[i].name);
+    }
+    fprintf(f, "\n} ;\n\n#endif\n");
+    fclose(f);
+}
+
+int main(int argc, char **argv){
+    FILE *f;
+    if(argc != 3){
+        fprintf(stderr, "usage: %s device.csv output_prefix\n", argv[0]);
+        return 2;
+    }
+    source = argv[1];
+    f = fopen(source, "r");
+    if(f == NULL){
+        perror(source);
+        return 1;
+    }
+    parse(f);
+    fclose(f);
+    write_header(argv[2]);
+    write_source(argv[2]);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Check of the generated 28-pin tables against the hand-written ones they
+ * replaced. The baseline below is the former digital_io.c table content;
+ * every pin of pin_table and every peripheral is compared field by field
+ * (port, mask, PPS group and input code, analog channel, 5V flag, PPS
+ * registers and codes). 'make tables' also regenerates the tables with
+ * host/devgen and compares them with the committed files. By hand, from the
+ * project directory:
+ *
+ *     cc -std=gnu99 -fgnu89-inline -DDEVICE_PINS=28 -Ihost/sim -I. -o tables_check \
+ *        host/device_tables_check.c device_28pin.c host/sim/sim.c
+ *
+ * The exit status is 0 when the tables match.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <xc.h>
+#include "digital_io.h"
+
+#if DEVICE_PINS != 28
+#error "The baseline covers the 28-pin tables"
+#endif
+
+typedef struct{
+    const char *name;
+    const io_port *io;
+    unsigned short mask;
+    unsigned char pps_group;
+    unsigned char pps_input_code;
+    signed char analog_channel;
+    unsigned char flags;
+} baseline_pin;
+
+typedef struct{
+    const char *name;
+    const peripheral *generated;
+    volatile unsigned int *input_pps;
+    unsigned char output_pps_code;
+    unsigned char io;
+    unsigned char groups;
+} baseline_peripheral;
+
+static const baseline_pin pins[] = {
+    { "RA0",  &RA, 1,     PPS_GROUP1,   0, 0,         0 },
+    { "RA1",  &RA, 2,     PPS_GROUP2,   0, 1,         0 },
+    { "RA2",  &RA, 4,     PPS_GROUP3,   0, NO_ANALOG, 0 },
+    { "RA3",  &RA, 8,     PPS_GROUP4,   0, NO_ANALOG, 0 },
+    { "RA4",  &RA, 16,    PPS_GROUP3,   2, NO_ANALOG, 0 },
+    { "RB0",  &RB, 1,     PPS_GROUP4,   2, 2,         0 },
+    { "RB1",  &RB, 2,     PPS_GROUP2,   2, 3,         0 },
+    { "RB2",  &RB, 4,     PPS_GROUP3,   4, 4,         0 },
+    { "RB3",  &RB, 8,     PPS_GROUP1,   1, 5,         0 },
+    { "RB4",  &RB, 16,    PPS_GROUP1,   2, NO_ANALOG, 0 },
+    { "RB5",  &RB, 32,    PPS_GROUP2,   1, NO_ANALOG, PIN_5V_TOLERANT },
+    { "RB6",  &RB, 64,    PPS_GROUP3,   1, NO_ANALOG, PIN_5V_TOLERANT },
+    { "RB7",  &RB, 128,   PPS_GROUP1,   4, NO_ANALOG, PIN_5V_TOLERANT },
+    { "RB8",  &RB, 256,   PPS_GROUP2,   4, NO_ANALOG, PIN_5V_TOLERANT },
+    { "RB9",  &RB, 512,   PPS_GROUP4,   4, NO_ANALOG, PIN_5V_TOLERANT },
+    { "RB10", &RB, 1024,  PPS_GROUP4,   3, NO_ANALOG, PIN_5V_TOLERANT },
+    { "RB11", &RB, 2048,  PPS_GROUP2,   3, NO_ANALOG, PIN_5V_TOLERANT },
+    { "RB12", &RB, 4096,  PPS_NO_GROUP, 0, 12,        0 },
+    { "RB13", &RB, 8192,  PPS_GROUP3,   3, 11,        0 },
+    { "RB14", &RB, 16384, PPS_GROUP4,   1, 10,        0 },
+    { "RB15", &RB, 32768, PPS_GROUP1,   3, 9,         0 }
+};
+
+static const baseline_peripheral peripherals[] = {
+    { "INT1",    &INT1,    &INT1R,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP4) },
+    { "INT2",    &INT2,    &INT2R,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "INT3",    &INT3,    &INT3R,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP2) },
+    { "INT4",    &INT4,    &INT4R,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP1) },
+    { "T2CK",    &T2CK,    &T2CKR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP1) },
+    { "T3CK",    &T3CK,    &T3CKR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP2) },
+    { "T4CK",    &T4CK,    &T4CKR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "T5CK",    &T5CK,    &T5CKR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP4) },
+    { "IC1",     &IC1,     &IC1R,     NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "IC2",     &IC2,     &IC2R,     NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP4) },
+    { "IC3",     &IC3,     &IC3R,     NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP2) },
+    { "IC4",     &IC4,     &IC4R,     NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP1) },
+    { "IC5",     &IC5,     &IC5R,     NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "OC1",     &OC1,     NULL,      5,    OUTPUT, PPS_IN_GROUP(PPS_GROUP1) },
+    { "OC2",     &OC2,     NULL,      5,    OUTPUT, PPS_IN_GROUP(PPS_GROUP2) },
+    { "OC3",     &OC3,     NULL,      5,    OUTPUT, PPS_IN_GROUP(PPS_GROUP4) },
+    { "OC4",     &OC4,     NULL,      5,    OUTPUT, PPS_IN_GROUP(PPS_GROUP3) },
+    { "OC5",     &OC5,     NULL,      6,    OUTPUT, PPS_IN_GROUP(PPS_GROUP3) },
+    { "REFCLKI", &REFCLKI, &REFCLKIR, NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP1) },
+    { "REFCLKO", &REFCLKO, NULL,      7,    OUTPUT, PPS_IN_GROUP(PPS_GROUP3) },
+    { "U1CTS",   &U1CTS,   &U1CTSR,   NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP2) },
+    { "U1RTS",   &U1RTS,   NULL,      1,    OUTPUT, PPS_IN_GROUP(PPS_GROUP4) },
+    { "U1RX",    &U1RX,    &U1RXR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "U1TX",    &U1TX,    NULL,      1,    OUTPUT, PPS_IN_GROUP(PPS_GROUP1) },
+    { "U2CTS",   &U2CTS,   &U2CTSR,   NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "U2RTS",   &U2RTS,   NULL,      2,    OUTPUT, PPS_IN_GROUP(PPS_GROUP1) },
+    { "U2RX",    &U2RX,    &U2RXR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP2) },
+    { "U2TX",    &U2TX,    NULL,      2,    OUTPUT, PPS_IN_GROUP(PPS_GROUP4) },
+    { "SDI1",    &SDI1,    &SDI1R,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP2) },
+    { "SDO1",    &SDO1,    NULL,      3,    OUTPUT, PPS_IN_GROUP(PPS_GROUP2) | PPS_IN_GROUP(PPS_GROUP3) },
+    { "SS1",     &SS1,     &SS1R,     NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP1) },
+    { "SDI2",    &SDI2,    &SDI2R,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "SDO2",    &SDO2,    NULL,      4,    OUTPUT, PPS_IN_GROUP(PPS_GROUP2) | PPS_IN_GROUP(PPS_GROUP3) },
+    { "SS2",     &SS2,     &SS2R,     NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP4) },
+    { "OCFA",    &OCFA,    &OCFAR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP4) },
+    { "OCFB",    &OCFB,    &OCFBR,    NONE, INPUT,  PPS_IN_GROUP(PPS_GROUP3) },
+    { "C1OUT",   &C1OUT,   NULL,      7,    OUTPUT, PPS_IN_GROUP(PPS_GROUP4) },
+    { "C2OUT",   &C2OUT,   NULL,      7,    OUTPUT, PPS_IN_GROUP(PPS_GROUP1) },
+    { "C3OUT",   &C3OUT,   NULL,      7,    OUTPUT, PPS_IN_GROUP(PPS_GROUP2) }
+};
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+static unsigned int mismatches;
+
+static void field(const char *name, const char *what, long generated, long expected){
+    if(generated == expected) return;
+    mismatches++;
+    printf("%s: %s is %ld, expected %ld\n", name, what, generated, expected);
+}
+
+int main(void){
+    unsigned int i;
+
+    field("RA", "ANSEL", RA.base == &ANSELA, 1);
+    field("RA", "rp_offset", RA.rp_offset, 0x00);
+    field("RB", "ANSEL", RB.base == &ANSELB, 1);
+    field("RB", "rp_offset", RB.rp_offset, 0x2C);
+    field("pin_table", "PIN_COUNT", PIN_COUNT, COUNT(pins) + 1);
+    field("pin_table", "PIN_NONE entry", pin_table[PIN_NONE] == NULL, 1);
+
+    for(i = 0; i < COUNT(pins) && i + 1 < PIN_COUNT; i++){
+        const baseline_pin *b = &pins[i];
+        const pin *p = pin_table[i + 1];
+        if(p == NULL){
+            field(b->name, "present", 0, 1);
+            continue;
+        }
+        field(b->name, "port", p->io == b->io, 1);
+        field(b->name, "mask", p->mask, b->mask);
+        field(b->name, "PPS group", p->pps_group, b->pps_group);
+        field(b->name, "PPS input code", p->pps_input_code, b->pps_input_code);
+        field(b->name, "analog channel", p->analog_channel, b->analog_channel);
+        field(b->name, "5V tolerant", p->flags & PIN_5V_TOLERANT, b->flags & PIN_5V_TOLERANT);
+        field(b->name, "flags", p->flags, b->flags);
+    }
+
+    for(i = 0; i < COUNT(peripherals); i++){
+        const baseline_peripheral *b = &peripherals[i];
+        const peripheral *p = b->generated;
+        field(b->name, "input PPS register", p->input_pps == b->input_pps, 1);
+        field(b->name, "output PPS code", p->output_pps_code, b->output_pps_code);
+        field(b->name, "direction", p->io, b->io);
+        field(b->name, "PPS groups", p->groups, b->groups);
+    }
+
+    printf("device tables, 28-pin: %u pins, %u peripherals, %u mismatches\n",
+           (unsigned int)COUNT(pins), (unsigned int)COUNT(peripherals), mismatches);
+    return mismatches != 0;
+}
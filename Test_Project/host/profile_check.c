@@ -0,0 +1,262 @@
+/*
+ * Check of the pin profiles (profile.c) on the simulated SFRs of host/sim.
+ * Two profiles are built with the usual pin_* calls and captured, then the
+ * switches between them run under the store trace of the simulation. Every
+ * switch must leave the registers equal to the target image, store only the
+ * bits that differ (LATx: the pins changing level or role) with at most one
+ * store per register alias, and follow the documented glitch-safe order:
+ * CNEN OFF and new pulls ON, TRIS SET, ANSEL, input PPS/ODC/LAT, RPxnR,
+ * TRIS CLR, old pulls OFF, CNEN ON. 'make SHELL=sh profile' runs it for both
+ * packages; by hand, from the project directory:
+ *
+ *     cc -std=gnu99 -fgnu89-inline -DDEVICE_PINS=28 -Ihost/sim -I. -o profile_check \
+ *        host/profile_check.c profile.c digital_io.c device_28pin.c host/sim/sim.c
+ *
+ * The exit status is 0 when every check passes.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <xc.h>
+#include "profile.h"
+
+/* Input PPS registers in the order of pin_profile.input_pps, as in profile.c */
+static volatile unsigned int *const inputs[PROFILE_INPUTS] = {
+    &INT1R, &INT2R, &INT3R, &INT4R, &T2CKR, &T3CKR, &T4CKR, &T5CKR,
+    &IC1R, &IC2R, &IC3R, &IC4R, &IC5R, &REFCLKIR, &U1CTSR, &U1RXR,
+    &U2CTSR, &U2RXR, &SDI1R, &SS1R, &SDI2R, &SS2R, &OCFAR, &OCFBR
+};
+
+static const char *const reg_names[] = { "ANSEL", "TRIS", "PORT", "LAT", "ODC", "CNPU", "CNPD", "CNCON", "CNEN", "CNSTAT" };
+static const char *const alias_names[] = { "", "CLR", "SET", "INV" };
+
+static unsigned int checks, failures;
+
+static void check(int ok, const char *what){
+    checks++;
+    if(ok) return;
+    failures++;
+    printf("FAIL: %s\n", what);
+}
+
+/* The registers after a reset: every pin an input, no PPS mapping */
+static void reset(void){
+    unsigned char p, i;
+    for(p = 0; p < IO_PORTS; p++){
+        memset((void*)sim_io[p], 0, sizeof(sim_io[p]));
+        sim_io[p][IO_TRIS] = 0xFFFF;
+    }
+    memset((void*)sim_rp, 0, sizeof(sim_rp));
+    for(i = 0; i < PROFILE_INPUTS; i++) *inputs[i] = 0;
+    sim_fold();
+}
+
+/* RB0 HIGH, RB1 input with pull-up and CN, RB2 analog, RB3 U1TX, RB13 U1RX, RB5 open drain LOW, RB6 LOW */
+static void configure_a(void){
+    pin_set_output_high(&RB0);
+    pin_set_direction(&RB0, OUTPUT);
+    pin_assign_pull_up(&RB1, ON);
+    pin_assign_interrupt_on_change(&RB1, ON);
+    pin_select_working_mode(&RB2, ANALOGIC);
+    pin_assign_peripheral(&RB3, &U1TX);
+    pin_set_direction(&RB3, OUTPUT);
+    pin_assign_peripheral(&RB13, &U1RX);
+    pin_open_drain_selection(&RB5, ON);
+    pin_set_direction(&RB5, OUTPUT);
+    pin_set_direction(&RB6, OUTPUT);
+}
+
+/* RB0 input with pull-down, RB1 LOW, RB2 HIGH, RB3 LOW as GPIO, RB4 OC1, RA4 U1RX, RB5 push-pull HIGH, RB6 LOW */
+static void configure_b(void){
+    pin_assign_pull_down(&RB0, ON);
+    pin_set_direction(&RB1, OUTPUT);
+    pin_select_working_mode(&RB2, DIGITAL);
+    pin_set_output_high(&RB2);
+    pin_set_direction(&RB2, OUTPUT);
+    pin_set_direction(&RB3, OUTPUT);
+    pin_assign_peripheral(&RB4, &OC1);
+    pin_set_direction(&RB4, OUTPUT);
+    pin_assign_peripheral(&RA4, &U1RX);
+    pin_set_output_high(&RB5);
+    pin_set_direction(&RB5, OUTPUT);
+    pin_set_direction(&RB6, OUTPUT);
+}
+
+static const unsigned short *image_reg(const pin_profile *f, unsigned char reg){
+    switch(reg){
+        case IO_ANSEL: return f->ansel;
+        case IO_TRIS:  return f->tris;
+        case IO_LAT:   return f->lat;
+        case IO_ODC:   return f->odc;
+        case IO_CNPU:  return f->cnpu;
+        case IO_CNPD:  return f->cnpd;
+        case IO_CNEN:  return f->cnen;
+    }
+    return NULL;
+}
+
+static unsigned char rp_nibble(const pin_profile *f, unsigned char p, unsigned char n){
+    return (f->rp[p][n >> 3] >> ((n & 7) * 4)) & 0xF;
+}
+
+/* RPxnR of the k-th remappable pin, NULL past the last; the other RPxnR do not exist */
+static volatile unsigned int *rp_reg(unsigned char k, unsigned char *port, unsigned char *n){
+    unsigned char i;
+    const pin *q;
+    for(i = PIN_NONE + 1; i < PIN_COUNT; i++){
+        q = pin_table[i];
+        if(q->pps_group == PPS_NO_GROUP || k-- != 0) continue;
+        *port = q->io->index;
+        *n = __builtin_ctz(q->mask);
+        return IO_RP(q->io, *n);
+    }
+    return NULL;
+}
+
+static unsigned char input_nibble(const pin_profile *f, unsigned char i){
+    return (f->input_pps[i >> 3] >> ((i & 7) * 4)) & 0xF;
+}
+
+/* The live registers equal the image */
+static void check_registers(const pin_profile *f, const char *name){
+    static const unsigned char regs[] = { IO_ANSEL, IO_TRIS, IO_LAT, IO_ODC, IO_CNPU, IO_CNPD, IO_CNEN };
+    char what[96];
+    unsigned char p, r, n, i, ok = 1;
+    volatile unsigned int *rp;
+    sim_fold();
+    for(p = 0; p < IO_PORTS; p++)
+        for(r = 0; r < sizeof(regs); r++)
+            if((sim_io[p][regs[r]] & 0xFFFF) != image_reg(f, regs[r])[p]){
+                snprintf(what, sizeof(what), "%s: %s%c is 0x%04X, image 0x%04X", name, reg_names[regs[r] / 4], 'A' + p,
+                         sim_io[p][regs[r]] & 0xFFFF, image_reg(f, regs[r])[p]);
+                check(0, what);
+                ok = 0;
+            }
+    for(i = 0; (rp = rp_reg(i, &p, &n)) != NULL; i++)
+        if(*rp != rp_nibble(f, p, n)) ok = 0;
+    for(i = 0; i < PROFILE_INPUTS; i++)
+        if(*inputs[i] != input_nibble(f, i)) ok = 0;
+    snprintf(what, sizeof(what), "%s: registers equal the image", name);
+    check(ok, what);
+}
+
+/* Step of the glitch-safe order a store belongs to, 0 if it has none */
+static unsigned char phase(unsigned char reg, unsigned char alias){
+    if(alias == IO_CLR){
+        switch(reg){
+            case IO_CNEN: return 1;
+            case IO_ANSEL: return 3;
+            case IO_ODC: case IO_LAT: return 4;
+            case IO_TRIS: return 6;
+            case IO_CNPU: case IO_CNPD: return 7;
+        }
+    }
+    if(alias == IO_SET){
+        switch(reg){
+            case IO_CNPU: case IO_CNPD: return 1;
+            case IO_TRIS: return 2;
+            case IO_ANSEL: return 3;
+            case IO_ODC: case IO_LAT: return 4;
+            case IO_CNEN: return 8;
+        }
+    }
+    return 0;
+}
+
+/* Pins whose level or role (TRIS, ANSEL, ODC, RPxnR) differ: the LAT bits a switch may write */
+static unsigned short lat_allowed(const pin_profile *from, const pin_profile *to, unsigned char p){
+    unsigned short m = (from->lat[p] ^ to->lat[p]) | (from->tris[p] ^ to->tris[p]) | (from->ansel[p] ^ to->ansel[p]) | (from->odc[p] ^ to->odc[p]);
+    unsigned char n;
+    for(n = 0; n < 16; n++) /* Nibbles of pins without RPxnR are 0 in both images */
+        if(rp_nibble(from, p, n) != rp_nibble(to, p, n)) m |= 1 << n;
+    return m;
+}
+
+static void check_switch(const pin_profile *from, const pin_profile *to, const char *name){
+    char what[128];
+    unsigned int i, seen[IO_PORTS][SIM_IO_WORDS];
+    unsigned char p, n, k, reg, alias, step, last = 0, ok_order = 1, ok_delta = 1, found;
+    unsigned short bits, diff;
+    volatile unsigned int *r, *rp;
+
+    sim_trace_start();
+    profile_switch(to);
+    sim_trace_stop();
+    check(sim_trace_count <= SIM_TRACE_MAX, "trace fits");
+    memset(seen, 0, sizeof(seen));
+
+    for(i = 0; i < sim_trace_count && i < SIM_TRACE_MAX; i++){
+        r = sim_trace[i].reg;
+        found = 0;
+        for(p = 0; p < IO_PORTS && !found; p++){
+            if(r < &sim_io[p][0] || r >= &sim_io[p][SIM_IO_WORDS]) continue;
+            found = 1;
+            reg = (r - &sim_io[p][0]) & ~3;
+            alias = (r - &sim_io[p][0]) & 3;
+            bits = sim_trace[i].value;
+            step = phase(reg, alias);
+            if(step == 0 || image_reg(to, reg) == NULL){
+                snprintf(what, sizeof(what), "%s: unexpected store to %s%c%s", name, reg_names[reg / 4], 'A' + p, alias_names[alias]);
+                check(0, what);
+                continue;
+            }
+            diff = reg == IO_LAT ? lat_allowed(from, to, p) : image_reg(from, reg)[p] ^ image_reg(to, reg)[p];
+            /* SET only bits going to 1, CLR only bits going to 0, among those that may change */
+            if((bits & ~diff) || (alias == IO_SET ? (bits & ~image_reg(to, reg)[p]) : (bits & image_reg(to, reg)[p]))
+               || seen[p][reg + alias]++){
+                snprintf(what, sizeof(what), "%s: %s%c%s 0x%04X outside the delta 0x%04X or repeated", name,
+                         reg_names[reg / 4], 'A' + p, alias_names[alias], bits, diff);
+                check(0, what);
+                ok_delta = 0;
+            }
+        }
+        if(!found){
+            step = 4; /* Input PPS, unless the register is an RPxnR */
+            for(k = 0; (rp = rp_reg(k, &p, &n)) != NULL; k++)
+                if(rp == r){
+                    step = 5;
+                    if(sim_trace[i].value != rp_nibble(to, p, n) || rp_nibble(from, p, n) == rp_nibble(to, p, n)) ok_delta = 0;
+                }
+            if(step == 4){
+                for(k = 0; k < PROFILE_INPUTS && inputs[k] != r; k++);
+                if(k == PROFILE_INPUTS || sim_trace[i].value != input_nibble(to, k) || input_nibble(from, k) == input_nibble(to, k)) ok_delta = 0;
+            }
+        }
+        if(step != 0){
+            if(step < last) ok_order = 0;
+            last = step;
+        }
+    }
+
+    snprintf(what, sizeof(what), "%s: only the bits that differ are written", name);
+    check(ok_delta, what);
+    snprintf(what, sizeof(what), "%s: glitch-safe store order", name);
+    check(ok_order, what);
+    check_registers(to, name);
+    printf("%-8s %3u stores\n", name, sim_trace_count);
+}
+
+int main(void){
+    pin_profile a, b, same;
+
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    reset();
+    configure_a();
+    profile_capture(&a);
+    reset();
+    configure_b();
+    profile_capture(&b);
+    check(profile_active() == &b, "capture makes the profile active");
+
+    profile_switch(&a);
+    check_registers(&a, "B to A, untraced");
+    check_switch(&a, &b, "A to B");
+    check_switch(&b, &a, "B to A");
+
+    same = a;
+    check_switch(&a, &same, "A to A");
+    check(sim_trace_count == 0, "identical images: no store");
+
+    printf("pin profiles, %u-pin: %u checks, %u failed\n", DEVICE_PINS, checks, failures);
+    return failures != 0;
+}
@@ -0,0 +1,220 @@
+/*
+ * Profiler report. Reads a histogram taken by profiler.c and the ELF file of
+ * the firmware that produced it, and prints the share of the samples taken
+ * in every function. Build and run on the host:
+ *
+ *     cc -O2 -o profreport profreport.c
+ *     ./profreport ../dist/default/production/Test_Project.production.elf dump
+ *
+ * The dump is either the raw image (sizeof(profiler_image) bytes read from
+ * profiler_data() by a debugger) or a console log holding the "@PROF" line
+ * sent by profiler_dump_uart; the last such line is used. The functions come
+ * from the STT_FUNC entries of .symtab, so the ELF must not be stripped.
+ *
+ * A bucket covers 2^shift bytes and may hold the end of a function and the
+ * start of the next: its samples are split in proportion to the bytes of
+ * each function inside the bucket. Samples falling in no function are
+ * reported as [no symbol], those outside the buckets as [outside].
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFILER_MAGIC 0x46504350UL
+#define HEADER_SIZE 24
+#define MAX_DUMP 65536
+#define PHYSICAL(a) ((a) & 0x1FFFFFFFUL)
+
+#define SHT_SYMTAB 2
+#define STT_FUNC 2
+
+typedef struct{
+    unsigned long start, end;
+    const char *name;
+    double samples;
+} function_desc;
+
+typedef struct{
+    unsigned long base;
+    unsigned int shift, halvings, buckets;
+    unsigned long rate_hz, samples, outside;
+    unsigned int *count;
+} histogram;
+
+static function_desc *functions;
+static int functions_count;
+
+static void fail(const char *message, const char *what){
+    fprintf(stderr, "profreport: %s%s%s\n", message, what ? ": " : "", what ? what : "");
+    exit(1);
+}
+
+static unsigned long le16(const unsigned char *p){
+    return p[0] | (unsigned long)p[1] << 8;
+}
+
+static unsigned long le32(const unsigned char *p){
+    return le16(p) | le16(p + 2) << 16;
+}
+
+static unsigned char *load(const char *path, long *size){
+    FILE *f = fopen(path, "rb");
+    unsigned char *data;
+    if(f == NULL) fail("cannot open", path);
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = malloc(*size + 1);
+    if(data == NULL || fread(data, 1, *size, f) != (size_t)*size) fail("cannot read", path);
+    data[*size] = 0;
+    fclose(f);
+    return data;
+}
+
+static int by_start(const void *a, const void *b){
+    const function_desc *x = a, *y = b;
+    return x->start < y->start ? -1 : x->start > y->start;
+}
+
+static int by_samples(const void *a, const void *b){
+    const function_desc *x = a, *y = b;
+    return x->samples < y->samples ? 1 : x->samples > y->samples ? -1 : strcmp(x->name, y->name);
+}
+
+/* ELF32 little endian: section headers, then every .symtab with its string table */
+static void read_symbols(const char *path){
+    long size;
+    unsigned char *elf = load(path, &size);
+    unsigned long shoff, shentsize, shnum, i, j;
+
+    if(size < 52 || memcmp(elf, "\177ELF", 4) || elf[4] != 1 || elf[5] != 1)
+        fail("not a 32-bit little endian ELF file", path);
+    shoff = le32(elf + 32);
+    shentsize = le16(elf + 46);
+    shnum = le16(elf + 48);
+    if(shoff + shnum * shentsize > (unsigned long)size) fail("truncated section table", path);
+
+    for(i = 0; i < shnum; i++){
+        const unsigned char *sh = elf + shoff + i * shentsize, *strsh;
+        unsigned long offset, length, entsize, strtab;
+        if(le32(sh + 4) != SHT_SYMTAB) continue;
+        offset = le32(sh + 16);
+        length = le32(sh + 20);
+        entsize = le32(sh + 36);
+        strsh = elf + shoff + le32(sh + 24) * shentsize;
+        strtab = le32(strsh + 16);
+        if(entsize < 16 || offset + length > (unsigned long)size) fail("bad symbol table", path);
+        functions = realloc(functions, (functions_count + length / entsize) * sizeof(*functions));
+        for(j = 0; j < length / entsize; j++){
+            const unsigned char *sym = elf + offset + j * entsize;
+            unsigned long value = le32(sym + 4), bytes = le32(sym + 8);
+            if((sym[12] & 15) != STT_FUNC || bytes == 0) continue;
+            /* Physical address, without the microMIPS mode bit */
+            value = PHYSICAL(value) & ~1UL;
+            functions[functions_count].start = value;
+            functions[functions_count].end = value + bytes;
+            functions[functions_count].name = (const char*)elf + strtab + le32(sym);
+            functions[functions_count].samples = 0;
+            functions_count++;
+        }
+    }
+    if(functions_count == 0) fail("no function symbols (stripped?)", path);
+    qsort(functions, functions_count, sizeof(*functions), by_start);
+}
+
+/* The raw image, or the hex of the last @PROF line of a log */
+static unsigned char *read_image(const char *path, long *size){
+    unsigned char *data = load(path, size), *image;
+    char *line = NULL, *p;
+    long n = 0;
+
+    if(*size >= HEADER_SIZE && le32(data) == PROFILER_MAGIC) return data;
+    for(p = (char*)data; (p = strstr(p, "@PROF ")) != NULL; p++) line = p + 6;
+    if(line == NULL) fail("no profiler image", path);
+    image = malloc(MAX_DUMP);
+    while(n < MAX_DUMP && sscanf(line, "%2hhx", &image[n]) == 1 && line[1]){
+        line += 2;
+        n++;
+    }
+    *size = n;
+    return image;
+}
+
+static void parse(const unsigned char *image, long size, histogram *h){
+    unsigned int i;
+    if(size < HEADER_SIZE || le32(image) != PROFILER_MAGIC) fail("bad profiler image", NULL);
+    h->base = PHYSICAL(le32(image + 4));
+    h->shift = image[8];
+    h->halvings = image[9];
+    h->buckets = le16(image + 10);
+    h->rate_hz = le32(image + 12);
+    h->samples = le32(image + 16);
+    h->outside = le32(image + 20);
+    if(h->shift > 24 || size < HEADER_SIZE + 2L * h->buckets) fail("truncated profiler image", NULL);
+    h->count = malloc(h->buckets * sizeof(*h->count));
+    for(i = 0; i < h->buckets; i++) h->count[i] = le16(image + HEADER_SIZE + 2 * i);
+}
+
+/* Splits every bucket across the functions it overlaps, returns the unmatched samples */
+static double attribute(const histogram *h){
+    unsigned long size = 1UL << h->shift, start, end, from, to;
+    double unmatched = 0, matched;
+    unsigned int i;
+    int f;
+
+    for(i = 0; i < h->buckets; i++){
+        if(h->count[i] == 0) continue;
+        start = h->base + i * size;
+        end = start + size;
+        matched = 0;
+        for(f = 0; f < functions_count && functions[f].start < end; f++){
+            if(functions[f].end <= start) continue;
+            from = functions[f].start > start ? functions[f].start : start;
+            to = functions[f].end < end ? functions[f].end : end;
+            functions[f].samples += (double)h->count[i] * (to - from) / size;
+            matched += (double)h->count[i] * (to - from) / size;
+        }
+        unmatched += h->count[i] - matched;
+    }
+    return unmatched;
+}
+
+int main(int argc, char **argv){
+    histogram h;
+    unsigned char *image;
+    long size;
+    double unmatched, total;
+    unsigned long bucketed = 0;
+    unsigned int i;
+    int f;
+
+    if(argc != 3){
+        fprintf(stderr, "usage: profreport <firmware.elf> <dump>\n");
+        return 2;
+    }
+    read_symbols(argv[1]);
+    image = read_image(argv[2], &size);
+    parse(image, size, &h);
+    for(i = 0; i < h.buckets; i++) bucketed += h.count[i];
+    unmatched = attribute(&h);
+    total = bucketed + h.outside;
+
+    printf("%lu samples at %lu Hz (%.1f s), buckets of %lu bytes from 0x%08lX\n",
+           h.samples, h.rate_hz, h.rate_hz ? (double)h.samples / h.rate_hz : 0.0, 1UL << h.shift, h.base);
+    if(h.halvings)
+        printf("buckets halved %u times: counts are about 1/%lu of the samples taken\n", h.halvings, 1UL << h.halvings);
+    if(total == 0){
+        printf("no samples\n");
+        return 0;
+    }
+
+    qsort(functions, functions_count, sizeof(*functions), by_samples);
+    printf("\n%7s %10s  %s\n", "%", "samples", "function");
+    for(f = 0; f < functions_count && functions[f].samples > 0; f++)
+        printf("%6.2f%% %10.1f  %s\n", 100 * functions[f].samples / total, functions[f].samples, functions[f].name);
+    if(unmatched > 0.05)
+        printf("%6.2f%% %10.1f  [no symbol]\n", 100 * unmatched / total, unmatched);
+    if(h.outside)
+        printf("%6.2f%% %10lu  [outside]\n", 100 * h.outside / total, h.outside);
+    return 0;
+}
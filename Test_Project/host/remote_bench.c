@@ -0,0 +1,111 @@
+/*
+ * Throughput of the remote GPIO protocol against a board running
+ * remote_gpio_poll(): one operation per round trip, batched operations and
+ * pipelined batches. Build on Linux with
+ *
+ *     cc -O2 -o remote_bench remote_bench.c remote_client.c ../remote_protocol.c
+ *
+ * and run as remote_bench /dev/ttyUSB0 115200. The benchmark toggles RB0-RB3
+ * and reads RB: leave them free.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "remote_client.h"
+
+#define TIMEOUT_MS 500
+#define ROUNDS 200
+/* Bytes of a batch of BATCH_OPS operations stay well below the device buffer */
+#define BATCH_OPS 16
+#define WINDOW 2
+
+static double now_s(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void fill(remote_batch *b, unsigned int round){
+    unsigned int i;
+    remote_batch_init(b);
+    for(i = 0; i < BATCH_OPS; i++){
+        if(i & 1) remote_port_read(b, 1);
+        else remote_port_write(b, REMOTE_PORT_B, 0x000F, (round + i) & 0x000F);
+    }
+}
+
+static int single(remote_client *c){
+    remote_batch b;
+    remote_result r;
+    unsigned int i;
+    double start = now_s(), elapsed;
+    for(i = 0; i < ROUNDS; i++){
+        remote_batch_init(&b);
+        remote_port_write(&b, REMOTE_PORT_B, 0x000F, i & 0x000F);
+        if(remote_transact(c, &b, &r, TIMEOUT_MS) < 0 || r.status != REMOTE_OK) return -1;
+    }
+    elapsed = now_s() - start;
+    printf("single   %8.0f ops/s  %7.3f ms/round trip\n", ROUNDS / elapsed, elapsed * 1000 / ROUNDS);
+    return 0;
+}
+
+static int batched(remote_client *c){
+    remote_batch b;
+    remote_result r;
+    unsigned int i;
+    double start = now_s(), elapsed;
+    for(i = 0; i < ROUNDS; i++){
+        fill(&b, i);
+        if(remote_transact(c, &b, &r, TIMEOUT_MS) < 0 || r.status != REMOTE_OK) return -1;
+    }
+    elapsed = now_s() - start;
+    printf("batched  %8.0f ops/s  %7.3f ms/round trip (%d ops/frame)\n", ROUNDS * BATCH_OPS / elapsed, elapsed * 1000 / ROUNDS, BATCH_OPS);
+    return 0;
+}
+
+static int pipelined(remote_client *c){
+    remote_batch b;
+    remote_result r;
+    int seqs[WINDOW];
+    unsigned int sent = 0, done = 0;
+    double start = now_s(), elapsed;
+    while(done < ROUNDS){
+        while(sent < ROUNDS && sent - done < WINDOW){
+            fill(&b, sent);
+            if((seqs[sent % WINDOW] = remote_send(c, &b)) < 0) return -1;
+            sent++;
+        }
+        if(remote_wait(c, seqs[done % WINDOW], &r, TIMEOUT_MS) < 0 || r.status != REMOTE_OK) return -1;
+        done++;
+    }
+    elapsed = now_s() - start;
+    printf("pipeline %8.0f ops/s  (%d ops/frame, %d frames in flight)\n", ROUNDS * BATCH_OPS / elapsed, BATCH_OPS, WINDOW);
+    return 0;
+}
+
+int main(int argc, char **argv){
+    remote_client c;
+    remote_batch b;
+    remote_result r;
+    if(argc < 2){
+        fprintf(stderr, "usage: %s device [baud]\n", argv[0]);
+        return 2;
+    }
+    if(remote_open(&c, argv[1], argc > 2 ? strtoul(argv[2], NULL, 0) : 115200) < 0){
+        perror(argv[1]);
+        return 1;
+    }
+    remote_batch_init(&b);
+    remote_port_direction(&b, REMOTE_PORT_B, 0x000F, 0x0000);
+    if(remote_transact(&c, &b, &r, TIMEOUT_MS) < 0 || r.status != REMOTE_OK){
+        fprintf(stderr, "no answer from the device\n");
+        return 1;
+    }
+    if(single(&c) < 0 || batched(&c) < 0 || pipelined(&c) < 0){
+        fprintf(stderr, "lost response\n");
+        return 1;
+    }
+    printf("dropped frames: %lu\n", c.dropped);
+    remote_close(&c);
+    return 0;
+}
@@ -0,0 +1,214 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "remote_client.h"
+
+static speed_t baud_to_speed(unsigned long baud){
+    switch(baud){
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        case 1000000: return B1000000;
+        default: return 0;
+    }
+}
+
+int remote_open(remote_client *c, const char *path, unsigned long baud){
+    struct termios t;
+    memset(c, 0, sizeof(*c));
+    c->fd = open(path, O_RDWR | O_NOCTTY);
+    if(c->fd < 0) return -1;
+    if(tcgetattr(c->fd, &t) == 0){
+        cfmakeraw(&t);
+        t.c_cflag |= CLOCAL | CREAD;
+        t.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+        t.c_cc[VMIN] = 0;
+        t.c_cc[VTIME] = 0;
+        if(baud != 0){
+            if(baud_to_speed(baud) == 0){
+                close(c->fd);
+                errno = EINVAL;
+                return -1;
+            }
+            cfsetispeed(&t, baud_to_speed(baud));
+            cfsetospeed(&t, baud_to_speed(baud));
+        }
+        tcsetattr(c->fd, TCSANOW, &t);
+        tcflush(c->fd, TCIOFLUSH);
+    }
+    return 0;
+}
+
+void remote_close(remote_client *c){
+    if(c->fd >= 0) close(c->fd);
+    c->fd = -1;
+}
+
+void remote_set_event_handler(remote_client *c, remote_event_handler handler, void *context){
+    c->on_event = handler;
+    c->context = context;
+}
+
+void remote_batch_init(remote_batch *b){
+    b->length = 0;
+    b->results = 0;
+}
+
+static int append(remote_batch *b, const unsigned char *op, unsigned int length, unsigned int results){
+    int offset = b->results;
+    if(b->length + length > REMOTE_MAX_BODY || 2 + b->results + results > REMOTE_MAX_BODY) return -1;
+    memcpy(b->body + b->length, op, length);
+    b->length += length;
+    b->results += results;
+    return offset;
+}
+
+int remote_port_write(remote_batch *b, unsigned char port, unsigned short mask, unsigned short value){
+    unsigned char op[6] = { REMOTE_OP_PORT_WRITE, port, mask >> 8, mask, value >> 8, value };
+    return append(b, op, sizeof(op), 0) < 0 ? -1 : 0;
+}
+
+int remote_port_direction(remote_batch *b, unsigned char port, unsigned short mask, unsigned short inputs){
+    unsigned char op[6] = { REMOTE_OP_PORT_DIR, port, mask >> 8, mask, inputs >> 8, inputs };
+    return append(b, op, sizeof(op), 0) < 0 ? -1 : 0;
+}
+
+int remote_pull(remote_batch *b, unsigned char port, unsigned short mask, unsigned short up, unsigned short down){
+    unsigned char op[8] = { REMOTE_OP_PULL, port, mask >> 8, mask, up >> 8, up, down >> 8, down };
+    return append(b, op, sizeof(op), 0) < 0 ? -1 : 0;
+}
+
+int remote_port_read(remote_batch *b, unsigned char port){
+    unsigned char op[2] = { REMOTE_OP_PORT_READ, port };
+    return append(b, op, sizeof(op), 2);
+}
+
+int remote_group_read(remote_batch *b, const unsigned char *pins, unsigned char count){
+    unsigned char op[2 + REMOTE_MAX_GROUP];
+    if(count > REMOTE_MAX_GROUP) return -1;
+    op[0] = REMOTE_OP_GROUP_READ;
+    op[1] = count;
+    memcpy(op + 2, pins, count);
+    return append(b, op, 2 + count, 2);
+}
+
+int remote_pps_assign(remote_batch *b, unsigned char pin, unsigned char peripheral){
+    unsigned char op[3] = { REMOTE_OP_PPS_ASSIGN, pin, peripheral };
+    return append(b, op, sizeof(op), 1);
+}
+
+int remote_cn_subscribe(remote_batch *b, unsigned char port, unsigned short mask){
+    unsigned char op[4] = { REMOTE_OP_CN_SUBSCRIBE, port, mask >> 8, mask };
+    return append(b, op, sizeof(op), 0) < 0 ? -1 : 0;
+}
+
+static int write_all(int fd, const unsigned char *data, unsigned int length){
+    ssize_t n;
+    while(length){
+        n = write(fd, data, length);
+        if(n < 0){
+            if(errno == EINTR || errno == EAGAIN) continue;
+            return -1;
+        }
+        data += n;
+        length -= n;
+    }
+    return 0;
+}
+
+int remote_send(remote_client *c, const remote_batch *b){
+    unsigned char payload[REMOTE_MAX_PAYLOAD], frame[REMOTE_MAX_FRAME];
+    unsigned char seq = c->next_seq++;
+    payload[0] = REMOTE_REQUEST;
+    payload[1] = seq;
+    memcpy(payload + 2, b->body, b->length);
+    c->ready[seq] = 0;
+    if(write_all(c->fd, frame, remote_encode(payload, 2 + b->length, frame)) < 0) return -1;
+    return seq;
+}
+
+static void dispatch(remote_client *c, const unsigned char *payload, unsigned int length){
+    remote_result *r;
+    unsigned int lost;
+    if(payload[0] == REMOTE_RESPONSE && length >= 4){
+        r = &c->results[payload[1]];
+        r->status = payload[2];
+        r->failed = payload[3];
+        r->length = length - 4;
+        memcpy(r->data, payload + 4, r->length);
+        c->ready[payload[1]] = 1;
+    }
+    else if(payload[0] == REMOTE_EVENT && length == 7){
+        lost = c->events_seen ? (unsigned char)(payload[1] - c->event_seq) : 0;
+        c->event_seq = payload[1] + 1;
+        c->events_seen = 1;
+        if(c->on_event != NULL)
+            c->on_event(c->context, payload[2], (payload[3] << 8) | payload[4], (payload[5] << 8) | payload[6], lost);
+    }
+    else c->dropped++;
+}
+
+static long now_ms(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+}
+
+/* Reads what is available within the timeout and dispatches complete frames */
+static int receive(remote_client *c, int timeout_ms){
+    unsigned char chunk[256], payload[REMOTE_MAX_PAYLOAD];
+    struct pollfd p = { c->fd, POLLIN, 0 };
+    unsigned int length;
+    ssize_t n, i;
+    int ready = poll(&p, 1, timeout_ms);
+    if(ready < 0) return errno == EINTR ? 0 : -1;
+    if(ready == 0) return 0;
+    n = read(c->fd, chunk, sizeof(chunk));
+    if(n < 0) return (errno == EINTR || errno == EAGAIN) ? 0 : -1;
+    for(i = 0; i < n; i++){
+        if(!remote_receive(&c->receiver, chunk[i])) continue;
+        length = remote_decode(&c->receiver, payload);
+        if(length < 2) c->dropped++;
+        else dispatch(c, payload, length);
+    }
+    return 0;
+}
+
+int remote_wait(remote_client *c, int seq, remote_result *r, int timeout_ms){
+    long deadline = now_ms() + timeout_ms, left;
+    while(!c->ready[seq & 0xFF]){
+        left = deadline - now_ms();
+        if(left <= 0 || receive(c, (int)left) < 0) return -1;
+    }
+    c->ready[seq & 0xFF] = 0;
+    if(r != NULL) *r = c->results[seq & 0xFF];
+    return 0;
+}
+
+int remote_transact(remote_client *c, const remote_batch *b, remote_result *r, int timeout_ms){
+    int seq = remote_send(c, b);
+    if(seq < 0) return -1;
+    return remote_wait(c, seq, r, timeout_ms);
+}
+
+int remote_poll_events(remote_client *c, int timeout_ms){
+    long deadline = now_ms() + timeout_ms, left;
+    do{
+        left = deadline - now_ms();
+        if(receive(c, left > 0 ? (int)left : 0) < 0) return -1;
+    }while(left > 0);
+    return 0;
+}
+
+unsigned short remote_result_u16(const remote_result *r, int offset){
+    return (r->data[offset] << 8) | r->data[offset + 1];
+}
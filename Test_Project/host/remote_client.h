@@ -0,0 +1,158 @@
+#ifndef _REMOTE_CLIENT_H
+#define _REMOTE_CLIENT_H
+
+/*
+ * Host side of the remote GPIO protocol (POSIX, Linux). Operations are
+ * collected in a remote_batch and sent as one frame; every read-like
+ * operation returns the offset of its result in the response data.
+ */
+
+#include "../remote_protocol.h"
+
+/**
+ @Summary
+    A request being built: up to REMOTE_MAX_BODY bytes of operations
+ */
+typedef struct{
+    unsigned char body[REMOTE_MAX_BODY];
+    unsigned int length;
+    unsigned int results;
+} remote_batch;
+
+/**
+ @Summary
+    A response: status, index of the failing operation and the result bytes
+ */
+typedef struct{
+    unsigned char status;
+    unsigned char failed;
+    unsigned int length;
+    unsigned char data[REMOTE_MAX_BODY];
+} remote_result;
+
+/**
+ @Summary
+    Called for every Change Notification event; <code>lost</code> counts the
+    events dropped by the device before this one.
+ */
+typedef void (*remote_event_handler)(void *context, unsigned char port, unsigned short changed, unsigned short value, unsigned int lost);
+
+/**
+ @Summary
+    A connection to a device. Responses that arrive while waiting for
+    another sequence number are kept until claimed.
+ */
+typedef struct{
+    int fd;
+    unsigned char next_seq;
+    unsigned char event_seq;
+    unsigned char events_seen;
+    remote_receiver receiver;
+    unsigned char ready[256];
+    remote_result results[256];
+    remote_event_handler on_event;
+    void *context;
+    unsigned long dropped;
+} remote_client;
+
+/**
+@Function
+    int remote_open(remote_client *c, const char *path, unsigned long baud)
+
+@Summary
+    The function opens the serial device in raw 8N1 mode. With
+    <code>baud</code> = 0 the speed is left untouched (pseudo terminals).
+
+@Returns
+    0 on success, -1 on error (errno set).
+*/
+extern int remote_open(remote_client *c, const char *path, unsigned long baud);
+
+extern void remote_close(remote_client *c);
+
+/**
+@Function
+    void remote_set_event_handler(remote_client *c, remote_event_handler handler, void *context)
+
+@Summary
+    The function sets the handler called for the events received while
+    waiting for responses or in <code>remote_poll_events</code>.
+*/
+extern void remote_set_event_handler(remote_client *c, remote_event_handler handler, void *context);
+
+extern void remote_batch_init(remote_batch *b);
+
+/*
+ * Batch builders. They return -1 when the operation does not fit in the
+ * batch; write-like operations return 0, read-like operations the offset
+ * of their result in remote_result.data.
+ */
+extern int remote_port_write(remote_batch *b, unsigned char port, unsigned short mask, unsigned short value);
+extern int remote_port_direction(remote_batch *b, unsigned char port, unsigned short mask, unsigned short inputs);
+extern int remote_pull(remote_batch *b, unsigned char port, unsigned short mask, unsigned short up, unsigned short down);
+extern int remote_port_read(remote_batch *b, unsigned char port);
+/* Pins are REMOTE_PIN(port, bit) codes, groups up to REMOTE_MAX_GROUP pins */
+extern int remote_group_read(remote_batch *b, const unsigned char *pins, unsigned char count);
+extern int remote_pps_assign(remote_batch *b, unsigned char pin, unsigned char peripheral);
+extern int remote_cn_subscribe(remote_batch *b, unsigned char port, unsigned short mask);
+
+/**
+@Function
+    int remote_send(remote_client *c, const remote_batch *b)
+
+@Summary
+    The function sends the batch without waiting for its response.
+
+@Remarks
+    Requests can be pipelined: keep the bytes in flight below the receive
+    buffer of the device (UART_RX_BUFFER, 256 bytes by default).
+
+@Returns
+    The sequence number of the request, -1 on error.
+*/
+extern int remote_send(remote_client *c, const remote_batch *b);
+
+/**
+@Function
+    int remote_wait(remote_client *c, int seq, remote_result *r, int timeout_ms)
+
+@Summary
+    The function waits for the response to <code>seq</code>, dispatching the
+    events and keeping the other responses received in the meantime.
+
+@Returns
+    0 when the response is in <code>r</code>, -1 on timeout or error.
+*/
+extern int remote_wait(remote_client *c, int seq, remote_result *r, int timeout_ms);
+
+/**
+@Function
+    int remote_transact(remote_client *c, const remote_batch *b, remote_result *r, int timeout_ms)
+
+@Summary
+    The function sends the batch and waits for its response.
+
+@Returns
+    0 when the response is in <code>r</code>, -1 on timeout or error.
+*/
+extern int remote_transact(remote_client *c, const remote_batch *b, remote_result *r, int timeout_ms);
+
+/**
+@Function
+    int remote_poll_events(remote_client *c, int timeout_ms)
+
+@Summary
+    The function processes incoming frames for up to <code>timeout_ms</code>.
+
+@Returns
+    0, -1 on error.
+*/
+extern int remote_poll_events(remote_client *c, int timeout_ms);
+
+/**
+ @Summary
+    16-bit result at <code>offset</code> (PORT and GROUP reads)
+ */
+extern unsigned short remote_result_u16(const remote_result *r, int offset);
+
+#endif
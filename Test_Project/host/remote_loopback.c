@@ -0,0 +1,323 @@
+/*
+ * Loopback test of the remote GPIO protocol. The device side (remote_gpio.c,
+ * digital_io.c, interrupts.c and the device tables) runs in a thread on the
+ * simulated SFRs of host/sim, with UART1 replaced by the master side of a
+ * pseudo terminal pair; host/remote_client.c opens the slave side as it
+ * would open /dev/ttyUSB0. 'make loopback' builds and runs it for both
+ * packages; by hand, from the project directory:
+ *
+ *     cc -std=gnu99 -fgnu89-inline -DDEVICE_PINS=28 -Ihost/sim -I. -o loopback \
+ *        host/remote_loopback.c host/remote_client.c host/sim/sim.c remote_gpio.c \
+ *        remote_protocol.c digital_io.c interrupts.c device_28pin.c -lpthread
+ *
+ * The exit status is 0 when every check passes.
+ */
+#define _XOPEN_SOURCE 600
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <xc.h>
+#include "remote_gpio.h"
+#include "host/remote_client.h"
+
+#define TIMEOUT_MS 500
+
+/* The CN vector of interrupts.c, a plain function on the host */
+extern void change_notice_vector(void);
+
+static int device_fd;
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile int running = 1;
+static remote_client client;
+static unsigned int checks, failures;
+
+/* UART1 of the device: the master side of the pseudo terminal */
+unsigned char uart_init(const pin *tx, const pin *rx, unsigned long baud){
+    (void)tx;
+    (void)rx;
+    (void)baud;
+    return 1;
+}
+
+unsigned int uart_read(unsigned char *data, unsigned int length){
+    ssize_t n = read(device_fd, data, length);
+    return n > 0 ? (unsigned int)n : 0;
+}
+
+void uart_write(const unsigned char *data, unsigned int length){
+    ssize_t n;
+    while(length){
+        n = write(device_fd, data, length);
+        if(n < 0){
+            if(errno == EINTR || errno == EAGAIN) continue;
+            return;
+        }
+        data += n;
+        length -= n;
+    }
+}
+
+unsigned int uart_overruns(void){
+    return 0;
+}
+
+/* The device main loop */
+static void *device(void *arg){
+    (void)arg;
+    while(running){
+        pthread_mutex_lock(&sim_lock);
+        remote_gpio_poll();
+        pthread_mutex_unlock(&sim_lock);
+        usleep(100);
+    }
+    return NULL;
+}
+
+static void check(int condition, const char *what){
+    checks++;
+    if(condition) return;
+    failures++;
+    printf("FAIL: %s\n", what);
+}
+
+/* A register of the simulated device, read with the device stopped */
+static unsigned int device_reg(const io_port *io, unsigned char reg){
+    unsigned int value;
+    pthread_mutex_lock(&sim_lock);
+    value = *IO_REG(io, reg);
+    pthread_mutex_unlock(&sim_lock);
+    return value;
+}
+
+/* Drives the input pins of a port, taking the CN vector as the CPU would */
+static void drive(unsigned char port, unsigned short mask, unsigned short value){
+    unsigned int flag = 1u << (13 + port);
+    pthread_mutex_lock(&sim_lock);
+    if(sim_drive(port, mask, value)){
+        sim_fold();
+        if((IEC1 & flag) && sim_interrupts_enabled()) change_notice_vector();
+    }
+    pthread_mutex_unlock(&sim_lock);
+}
+
+static int transact(remote_batch *b, remote_result *r){
+    return remote_transact(&client, b, r, TIMEOUT_MS) == 0;
+}
+
+static void test_port(void){
+    remote_batch b;
+    remote_result r;
+    int read;
+    remote_batch_init(&b);
+    remote_port_direction(&b, REMOTE_PORT_B, 0x000F, 0x0000);
+    remote_port_write(&b, REMOTE_PORT_B, 0x000F, 0x000F);
+    remote_port_write(&b, REMOTE_PORT_B, 0x0003, 0x0000);
+    read = remote_port_read(&b, REMOTE_PORT_B);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "port batch answered");
+    check((remote_result_u16(&r, read) & 0x000F) == 0x000C, "two writes and a read in one batch");
+    check((device_reg(&RB, IO_TRIS) & 0x000F) == 0, "RB0-RB3 driven");
+    check((device_reg(&RB, IO_LAT) & 0x000F) == 0x000C, "LATB follows the writes");
+}
+
+static void test_group(void){
+    const unsigned char pins[4] = {
+        REMOTE_PIN(REMOTE_PORT_B, 8), REMOTE_PIN(REMOTE_PORT_B, 9),
+        REMOTE_PIN(REMOTE_PORT_B, 10), REMOTE_PIN(REMOTE_PORT_B, 11)
+    };
+    const unsigned char missing = REMOTE_PIN(REMOTE_PORT_A, 5);
+    remote_batch b;
+    remote_result r;
+    int read;
+    remote_batch_init(&b);
+    remote_port_direction(&b, REMOTE_PORT_B, 0x0F00, 0x0F00);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "RB8-RB11 turned to inputs");
+    drive(REMOTE_PORT_B, 0x0F00, 0x0500);
+    remote_batch_init(&b);
+    read = remote_group_read(&b, pins, 4);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "group read answered");
+    check(remote_result_u16(&r, read) == 0x0005, "group bits follow the pins");
+
+    remote_batch_init(&b);
+    remote_port_read(&b, REMOTE_PORT_B);
+    remote_group_read(&b, &missing, 1);
+    check(transact(&b, &r) && r.status == REMOTE_ERR_ARG && r.failed == 1 && r.length == 2, "RA5 refused after a read");
+}
+
+static void test_pull(void){
+    remote_batch b;
+    remote_result r;
+    remote_batch_init(&b);
+    remote_pull(&b, REMOTE_PORT_B, 0x00F0, 0x0030, 0x00C0);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "pull answered");
+    check((device_reg(&RB, IO_CNPU) & 0x00F0) == 0x0030, "CNPUB set");
+    check((device_reg(&RB, IO_CNPD) & 0x00F0) == 0x00C0, "CNPDB set");
+}
+
+static void test_pps(void){
+    remote_batch b;
+    remote_result r;
+    int legal, illegal;
+    unsigned int code;
+    remote_batch_init(&b);
+    legal = remote_pps_assign(&b, REMOTE_PIN(REMOTE_PORT_B, 7), REMOTE_U1TX);
+    illegal = remote_pps_assign(&b, REMOTE_PIN(REMOTE_PORT_A, 1), REMOTE_INT4);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "PPS batch answered");
+    check(r.data[legal] == 1 && r.data[illegal] == 0, "PPS legality reported");
+    pthread_mutex_lock(&sim_lock);
+    code = *IO_RP(&RB, 7);
+    pthread_mutex_unlock(&sim_lock);
+    check(code == U1TX.output_pps_code, "RPB7R holds the U1TX code");
+}
+
+static void test_errors(void){
+    remote_batch b;
+    remote_result r;
+    remote_batch_init(&b);
+    remote_port_read(&b, REMOTE_PORT_B);
+    remote_port_read(&b, IO_PORTS);
+    check(transact(&b, &r) && r.status == REMOTE_ERR_ARG && r.failed == 1, "port beyond IO_PORTS refused");
+    remote_batch_init(&b);
+    b.body[b.length++] = 0x7E;
+    check(transact(&b, &r) && r.status == REMOTE_ERR_OP && r.failed == 0, "unknown operation refused");
+}
+
+static void test_pipeline(void){
+    remote_batch b;
+    remote_result r;
+    int seq[8], read = 0, i, ok = 1;
+    for(i = 0; i < 8; i++){
+        remote_batch_init(&b);
+        remote_port_write(&b, REMOTE_PORT_B, 0x000F, i);
+        read = remote_port_read(&b, REMOTE_PORT_B);
+        seq[i] = remote_send(&client, &b);
+    }
+    /* Claimed in reverse order: the others are kept by the client */
+    for(i = 7; i >= 0; i--)
+        if(seq[i] < 0 || remote_wait(&client, seq[i], &r, TIMEOUT_MS) < 0 || (remote_result_u16(&r, read) & 0x000F) != i) ok = 0;
+    check(ok, "pipelined requests answered in order");
+}
+
+static unsigned int events, events_lost;
+static unsigned char event_port;
+static unsigned short event_changed, event_value;
+
+static void on_event(void *context, unsigned char port, unsigned short changed, unsigned short value, unsigned int lost){
+    (void)context;
+    events++;
+    events_lost += lost;
+    event_port = port;
+    event_changed = changed;
+    event_value = value;
+}
+
+static void test_events(void){
+    remote_batch b;
+    remote_result r;
+    remote_set_event_handler(&client, on_event, NULL);
+    remote_batch_init(&b);
+    remote_cn_subscribe(&b, REMOTE_PORT_B, 0x0100);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "subscribe answered");
+    drive(REMOTE_PORT_B, 0x0100, 0x0000);
+    drive(REMOTE_PORT_B, 0x0200, 0x0200); /* Not subscribed */
+    drive(REMOTE_PORT_B, 0x0100, 0x0100);
+    remote_poll_events(&client, 100);
+    check(events == 2 && events_lost == 0, "one event per subscribed change");
+    check(event_port == REMOTE_PORT_B && event_changed == 0x0100 && (event_value & 0x0100), "event carries port, change and level");
+#if IO_PORTS > 2
+    remote_batch_init(&b);
+    remote_port_direction(&b, REMOTE_PORT_C, 0x0001, 0x0001);
+    remote_cn_subscribe(&b, REMOTE_PORT_C, 0x0001);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "RC subscribe answered");
+    drive(REMOTE_PORT_C, 0x0001, 0x0001);
+    remote_poll_events(&client, 100);
+    check(events == 3 && event_port == REMOTE_PORT_C && event_changed == 0x0001, "RC event");
+#endif
+}
+
+static void other_owner(void){
+}
+
+/* Unsubscribing everything hands the CN vector over; a taken vector is refused */
+static void test_cn_owner(void){
+    remote_batch b;
+    remote_result r;
+    unsigned char attached;
+    remote_batch_init(&b);
+    remote_cn_subscribe(&b, REMOTE_PORT_B, 0);
+#if IO_PORTS > 2
+    remote_cn_subscribe(&b, REMOTE_PORT_C, 0);
+#endif
+    check(transact(&b, &r) && r.status == REMOTE_OK, "unsubscribe answered");
+    pthread_mutex_lock(&sim_lock);
+    attached = interrupt_attach(&CN_A, other_owner);
+    pthread_mutex_unlock(&sim_lock);
+    check(attached, "CN vector released after the last unsubscribe");
+    remote_batch_init(&b);
+    remote_cn_subscribe(&b, REMOTE_PORT_B, 0x0100);
+    check(transact(&b, &r) && r.status == REMOTE_ERR_BUSY && r.failed == 0, "subscribe refused while another module owns CN");
+    pthread_mutex_lock(&sim_lock);
+    interrupt_attach(&CN_A, NULL);
+    pthread_mutex_unlock(&sim_lock);
+    remote_batch_init(&b);
+    remote_cn_subscribe(&b, REMOTE_PORT_B, 0x0100);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "subscribe accepted once the vector is free");
+}
+
+static void test_corrupted(void){
+    unsigned char payload[REMOTE_MAX_PAYLOAD], frame[REMOTE_MAX_FRAME];
+    unsigned int length, dropped;
+    remote_batch b;
+    remote_result r;
+    payload[0] = REMOTE_REQUEST;
+    payload[1] = 0xC8;
+    payload[2] = REMOTE_OP_PORT_READ;
+    payload[3] = REMOTE_PORT_B;
+    length = remote_encode(payload, 4, frame);
+    frame[3] ^= 0x80; /* A data byte: the CRC no longer matches */
+    check(write(client.fd, frame, length) == (ssize_t)length, "corrupted frame sent");
+    remote_batch_init(&b);
+    remote_port_read(&b, REMOTE_PORT_B);
+    check(transact(&b, &r) && r.status == REMOTE_OK, "next request answered");
+    pthread_mutex_lock(&sim_lock);
+    dropped = remote_gpio_dropped();
+    pthread_mutex_unlock(&sim_lock);
+    check(dropped == 1 && !client.ready[0xC8], "corrupted frame dropped without answer");
+}
+
+int main(void){
+    pthread_t thread;
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if(master < 0 || grantpt(master) < 0 || unlockpt(master) < 0){
+        perror("remote_loopback: pseudo terminal");
+        return 2;
+    }
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    device_fd = master;
+    if(remote_open(&client, ptsname(master), 0) < 0){
+        perror("remote_loopback: slave side");
+        return 2;
+    }
+
+    interrupt_init();
+    remote_gpio_init(&RB7, &RB13, 115200);
+    pthread_create(&thread, NULL, device, NULL);
+
+    test_port();
+    test_group();
+    test_pull();
+    test_pps();
+    test_errors();
+    test_pipeline();
+    test_events();
+    test_cn_owner();
+    test_corrupted();
+
+    running = 0;
+    pthread_join(thread, NULL);
+    remote_close(&client);
+    printf("remote loopback, %d-pin: %u checks, %u failed\n", DEVICE_PINS, checks, failures);
+    return failures != 0;
+}
@@ -0,0 +1,121 @@
+#include <time.h>
+#include <xc.h>
+#include "digital_io.h"
+#include "interrupts.h"
+
+volatile unsigned int sim_io[SIM_PORTS][SIM_IO_WORDS];
+volatile unsigned int sim_rp[SIM_RP_WORDS];
+volatile unsigned int sim_sfr[SIM_SFRS][4];
+unsigned short sim_inputs[SIM_PORTS];
+volatile unsigned int INT1R, INT2R, INT3R, INT4R, T2CKR, T3CKR, T4CKR, T5CKR;
+volatile unsigned int IC1R, IC2R, IC3R, IC4R, IC5R, OCFAR, OCFBR, U1RXR;
+volatile unsigned int U1CTSR, U2RXR, U2CTSR, SDI1R, SS1R, SDI2R, SS2R, REFCLKIR;
+/* PORTx as last computed: a different value has been written by the code */
+static unsigned int port_shadow[SIM_PORTS];
+static unsigned int interrupts_on;
+
+sim_store sim_trace[SIM_TRACE_MAX];
+unsigned int sim_trace_count;
+static unsigned char tracing;
+static volatile unsigned int *const pps_inputs[] = {
+    &INT1R, &INT2R, &INT3R, &INT4R, &T2CKR, &T3CKR, &T4CKR, &T5CKR,
+    &IC1R, &IC2R, &IC3R, &IC4R, &IC5R, &OCFAR, &OCFBR, &U1RXR,
+    &U1CTSR, &U2RXR, &U2CTSR, &SDI1R, &SS1R, &SDI2R, &SS2R, &REFCLKIR
+};
+#define PPS_INPUTS (sizeof(pps_inputs) / sizeof(pps_inputs[0]))
+static unsigned int rp_shadow[SIM_RP_WORDS];
+static unsigned int pps_shadow[PPS_INPUTS];
+
+static void trace(volatile unsigned int *reg, unsigned int value){
+    if(sim_trace_count < SIM_TRACE_MAX){
+        sim_trace[sim_trace_count].reg = reg;
+        sim_trace[sim_trace_count].value = value;
+    }
+    sim_trace_count++;
+}
+
+/* Plain stores: what differs from the values seen at the previous fold */
+static void trace_plain(void){
+    unsigned int i;
+    for(i = 0; i < SIM_RP_WORDS; i++)
+        if(sim_rp[i] != rp_shadow[i]) trace(&sim_rp[i], rp_shadow[i] = sim_rp[i]);
+    for(i = 0; i < PPS_INPUTS; i++)
+        if(*pps_inputs[i] != pps_shadow[i]) trace(pps_inputs[i], pps_shadow[i] = *pps_inputs[i]);
+}
+
+static void fold(volatile unsigned int *r){
+    r[0] = ((r[0] & ~r[IO_CLR]) | r[IO_SET]) ^ r[IO_INV];
+    r[IO_CLR] = r[IO_SET] = r[IO_INV] = 0;
+}
+
+void sim_fold_port(unsigned char p){
+    unsigned char reg;
+    volatile unsigned int *b = sim_io[p];
+    if(tracing)
+        for(reg = IO_ANSEL + 1; reg < SIM_IO_WORDS; reg++)
+            if((reg & 3) != 0 && b[reg] != 0) trace(&b[reg], b[reg]);
+    /* PORTx and its aliases write LATx */
+    if(b[IO_PORT] != port_shadow[p]) b[IO_LAT] = b[IO_PORT];
+    b[IO_LAT + IO_CLR] |= b[IO_PORT + IO_CLR];
+    b[IO_LAT + IO_SET] |= b[IO_PORT + IO_SET];
+    b[IO_LAT + IO_INV] ^= b[IO_PORT + IO_INV];
+    b[IO_PORT + IO_CLR] = b[IO_PORT + IO_SET] = b[IO_PORT + IO_INV] = 0;
+    for(reg = IO_ANSEL; reg <= IO_CNSTAT; reg += 4)
+        if(reg != IO_PORT) fold(b + reg);
+    b[IO_PORT] = port_shadow[p] = ((b[IO_LAT] & ~b[IO_TRIS]) | (sim_inputs[p] & b[IO_TRIS])) & ~b[IO_ANSEL] & 0xFFFF;
+}
+
+void sim_fold(void){
+    unsigned char p, reg;
+    for(p = 0; p < SIM_PORTS; p++) sim_fold_port(p);
+    for(reg = 0; reg < SIM_SFRS; reg++) fold(sim_sfr[reg]);
+    if(tracing) trace_plain();
+}
+
+void sim_trace_start(void){
+    sim_fold();
+    tracing = 1;
+    sim_trace_count = 0;
+    trace_plain(); /* Takes the shadows: nothing is logged before this point */
+    sim_trace_count = 0;
+}
+
+void sim_trace_stop(void){
+    sim_fold(); /* The last stores are logged at the next fold */
+    tracing = 0;
+}
+
+unsigned char sim_drive(unsigned char port, unsigned short mask, unsigned short value){
+    unsigned int before, changed;
+    sim_fold();
+    before = sim_io[port][IO_PORT];
+    sim_inputs[port] = (sim_inputs[port] & ~mask) | (value & mask);
+    sim_fold();
+    changed = (before ^ sim_io[port][IO_PORT]) & sim_io[port][IO_CNEN];
+    if(changed == 0 || !(sim_io[port][IO_CNCON] & (1 << 15))) return 0;
+    /* CN flags of RA, RB, RC are IFS1<13..15> */
+    IFS1 |= 1 << (13 + port);
+    return 1;
+}
+
+unsigned int _CP0_GET_COUNT(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned int)((ts.tv_sec * 1000000000ULL + ts.tv_nsec) * (CORE_TIMER_FREQ / 1000000) / 1000);
+}
+
+unsigned int sim_disable_interrupts(void){
+    unsigned int status = interrupts_on;
+    interrupts_on = 0;
+    return status;
+}
+
+unsigned int sim_enable_interrupts(void){
+    unsigned int status = interrupts_on;
+    interrupts_on = 1;
+    return status;
+}
+
+unsigned char sim_interrupts_enabled(void){
+    return interrupts_on;
+}
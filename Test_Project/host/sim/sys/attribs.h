@@ -0,0 +1,17 @@
+#ifndef _SIM_ATTRIBS_H
+#define _SIM_ATTRIBS_H
+
+/* Host builds: the vectors are plain functions, called by the test harness */
+#define __ISR(vector, ipl)
+
+#define _CORE_TIMER_VECTOR 0
+#define _TIMER_1_VECTOR 4
+#define _TIMER_2_VECTOR 8
+#define _TIMER_3_VECTOR 12
+#define _TIMER_4_VECTOR 16
+#define _TIMER_5_VECTOR 20
+#define _UART_1_VECTOR 32
+#define _CHANGE_NOTICE_VECTOR 34
+#define _UART_2_VECTOR 37
+
+#endif
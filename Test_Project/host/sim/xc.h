@@ -0,0 +1,203 @@
+#ifndef _SIM_XC_H
+#define _SIM_XC_H
+
+/*
+ * Simulated SFRs for host builds of the library (the tests and benches of
+ * host/). It stands for the <xc.h> of XC32: every register is a word of
+ * RAM, laid out like on the device so the io_port bases, the IO_* offsets
+ * and the RPxnR offsets hold. Only the registers of the modules built on
+ * the host are declared.
+ *
+ * The CLR/SET/INV aliases are plain words: sim_fold() applies what has been
+ * written to them and is run by IO_REG before every port access, so a
+ * sequence of alias stores reads back as on the device. PORTx reads
+ * (LATx & ~TRISx) | (sim_inputs & TRISx), 0 for the analog pins, and PORTx
+ * writes go to LATx.
+ */
+
+#include <stddef.h>
+
+#define SIM_PORTS 3
+/* ANSEL to CNSTAT, with their aliases */
+#define SIM_IO_WORDS 40
+#define SIM_RP_WORDS 64
+
+extern volatile unsigned int sim_io[SIM_PORTS][SIM_IO_WORDS];
+extern volatile unsigned int sim_rp[SIM_RP_WORDS];
+extern unsigned short sim_inputs[SIM_PORTS];
+
+#define ANSELA sim_io[0][0]
+#define ANSELB sim_io[1][0]
+#define ANSELC sim_io[2][0]
+#define RPA0R  sim_rp[0]
+
+/*
+ * TRISx, PORTx and LATx by name, for the code storing to fixed SFRs
+ * (bitbang.c): every access folds the aliases of its port first, cheaper
+ * than the whole sim_fold() on the timed paths.
+ */
+#define SIM_REG(port, offset) (*(sim_fold_port(port), &sim_io[port][offset]))
+#define TRISA      SIM_REG(0, 4)
+#define TRISACLR   SIM_REG(0, 5)
+#define TRISASET   SIM_REG(0, 6)
+#define TRISAINV   SIM_REG(0, 7)
+#define PORTA      SIM_REG(0, 8)
+#define PORTACLR   SIM_REG(0, 9)
+#define PORTASET   SIM_REG(0, 10)
+#define PORTAINV   SIM_REG(0, 11)
+#define LATA       SIM_REG(0, 12)
+#define LATACLR    SIM_REG(0, 13)
+#define LATASET    SIM_REG(0, 14)
+#define LATAINV    SIM_REG(0, 15)
+#define TRISB      SIM_REG(1, 4)
+#define TRISBCLR   SIM_REG(1, 5)
+#define TRISBSET   SIM_REG(1, 6)
+#define TRISBINV   SIM_REG(1, 7)
+#define PORTB      SIM_REG(1, 8)
+#define PORTBCLR   SIM_REG(1, 9)
+#define PORTBSET   SIM_REG(1, 10)
+#define PORTBINV   SIM_REG(1, 11)
+#define LATB       SIM_REG(1, 12)
+#define LATBCLR    SIM_REG(1, 13)
+#define LATBSET    SIM_REG(1, 14)
+#define LATBINV    SIM_REG(1, 15)
+#define TRISC      SIM_REG(2, 4)
+#define TRISCCLR   SIM_REG(2, 5)
+#define TRISCSET   SIM_REG(2, 6)
+#define TRISCINV   SIM_REG(2, 7)
+#define PORTC      SIM_REG(2, 8)
+#define PORTCCLR   SIM_REG(2, 9)
+#define PORTCSET   SIM_REG(2, 10)
+#define PORTCINV   SIM_REG(2, 11)
+#define LATC       SIM_REG(2, 12)
+#define LATCCLR    SIM_REG(2, 13)
+#define LATCSET    SIM_REG(2, 14)
+#define LATCINV    SIM_REG(2, 15)
+
+enum{ SIM_INTCON, SIM_IFS0, SIM_IFS1, SIM_IEC0, SIM_IEC1, SIM_IPC0, SIM_IPC1, SIM_IPC2, SIM_IPC3, SIM_IPC4, SIM_IPC5, SIM_IPC6, SIM_IPC7, SIM_IPC8, SIM_IPC9, SIM_IPC10, SIM_SFRS };
+extern volatile unsigned int sim_sfr[SIM_SFRS][4];
+
+#define INTCON     sim_sfr[SIM_INTCON][0]
+#define INTCONCLR  sim_sfr[SIM_INTCON][1]
+#define INTCONSET  sim_sfr[SIM_INTCON][2]
+#define INTCONINV  sim_sfr[SIM_INTCON][3]
+#define IFS0       sim_sfr[SIM_IFS0][0]
+#define IFS0CLR    sim_sfr[SIM_IFS0][1]
+#define IFS0SET    sim_sfr[SIM_IFS0][2]
+#define IFS0INV    sim_sfr[SIM_IFS0][3]
+#define IFS1       sim_sfr[SIM_IFS1][0]
+#define IFS1CLR    sim_sfr[SIM_IFS1][1]
+#define IFS1SET    sim_sfr[SIM_IFS1][2]
+#define IFS1INV    sim_sfr[SIM_IFS1][3]
+#define IEC0       sim_sfr[SIM_IEC0][0]
+#define IEC0CLR    sim_sfr[SIM_IEC0][1]
+#define IEC0SET    sim_sfr[SIM_IEC0][2]
+#define IEC0INV    sim_sfr[SIM_IEC0][3]
+#define IEC1       sim_sfr[SIM_IEC1][0]
+#define IEC1CLR    sim_sfr[SIM_IEC1][1]
+#define IEC1SET    sim_sfr[SIM_IEC1][2]
+#define IEC1INV    sim_sfr[SIM_IEC1][3]
+#define IPC0       sim_sfr[SIM_IPC0][0]
+#define IPC0CLR    sim_sfr[SIM_IPC0][1]
+#define IPC0SET    sim_sfr[SIM_IPC0][2]
+#define IPC0INV    sim_sfr[SIM_IPC0][3]
+#define IPC1       sim_sfr[SIM_IPC1][0]
+#define IPC1CLR    sim_sfr[SIM_IPC1][1]
+#define IPC1SET    sim_sfr[SIM_IPC1][2]
+#define IPC1INV    sim_sfr[SIM_IPC1][3]
+#define IPC2       sim_sfr[SIM_IPC2][0]
+#define IPC2CLR    sim_sfr[SIM_IPC2][1]
+#define IPC2SET    sim_sfr[SIM_IPC2][2]
+#define IPC2INV    sim_sfr[SIM_IPC2][3]
+#define IPC3       sim_sfr[SIM_IPC3][0]
+#define IPC3CLR    sim_sfr[SIM_IPC3][1]
+#define IPC3SET    sim_sfr[SIM_IPC3][2]
+#define IPC3INV    sim_sfr[SIM_IPC3][3]
+#define IPC4       sim_sfr[SIM_IPC4][0]
+#define IPC4CLR    sim_sfr[SIM_IPC4][1]
+#define IPC4SET    sim_sfr[SIM_IPC4][2]
+#define IPC4INV    sim_sfr[SIM_IPC4][3]
+#define IPC5       sim_sfr[SIM_IPC5][0]
+#define IPC5CLR    sim_sfr[SIM_IPC5][1]
+#define IPC5SET    sim_sfr[SIM_IPC5][2]
+#define IPC5INV    sim_sfr[SIM_IPC5][3]
+#define IPC6       sim_sfr[SIM_IPC6][0]
+#define IPC6CLR    sim_sfr[SIM_IPC6][1]
+#define IPC6SET    sim_sfr[SIM_IPC6][2]
+#define IPC6INV    sim_sfr[SIM_IPC6][3]
+#define IPC7       sim_sfr[SIM_IPC7][0]
+#define IPC7CLR    sim_sfr[SIM_IPC7][1]
+#define IPC7SET    sim_sfr[SIM_IPC7][2]
+#define IPC7INV    sim_sfr[SIM_IPC7][3]
+#define IPC8       sim_sfr[SIM_IPC8][0]
+#define IPC8CLR    sim_sfr[SIM_IPC8][1]
+#define IPC8SET    sim_sfr[SIM_IPC8][2]
+#define IPC8INV    sim_sfr[SIM_IPC8][3]
+#define IPC9       sim_sfr[SIM_IPC9][0]
+#define IPC9CLR    sim_sfr[SIM_IPC9][1]
+#define IPC9SET    sim_sfr[SIM_IPC9][2]
+#define IPC9INV    sim_sfr[SIM_IPC9][3]
+#define IPC10      sim_sfr[SIM_IPC10][0]
+#define IPC10CLR   sim_sfr[SIM_IPC10][1]
+#define IPC10SET   sim_sfr[SIM_IPC10][2]
+#define IPC10INV   sim_sfr[SIM_IPC10][3]
+
+#define _INTCON_MVEC_MASK 0x1000
+
+/* Input PPS registers */
+extern volatile unsigned int INT1R, INT2R, INT3R, INT4R, T2CKR, T3CKR, T4CKR, T5CKR;
+extern volatile unsigned int IC1R, IC2R, IC3R, IC4R, IC5R, OCFAR, OCFBR, U1RXR;
+extern volatile unsigned int U1CTSR, U2RXR, U2CTSR, SDI1R, SS1R, SDI2R, SS2R, REFCLKIR;
+
+/* Every port access goes through IO_REG: fold the aliases first */
+#define IO_REG(io, reg) (sim_fold(), (io)->base + (reg))
+
+extern void sim_fold(void);
+extern void sim_fold_port(unsigned char port);
+
+/*
+ * Store trace, for the checks of a write order (host/profile_check.c).
+ * Between sim_trace_start and sim_trace_stop, sim_fold logs every CLR, SET
+ * and INV store to a port register, then every RPxnR and input PPS register
+ * that changed, in the order they are folded. IO_REG folds before every
+ * access, so each port store is logged on its own; RPxnR and input PPS are
+ * plain stores, logged at the next port access.
+ */
+#define SIM_TRACE_MAX 256
+
+typedef struct{
+    volatile unsigned int *reg;
+    unsigned int value;
+} sim_store;
+
+extern sim_store sim_trace[SIM_TRACE_MAX];
+extern unsigned int sim_trace_count;
+extern void sim_trace_start(void);
+extern void sim_trace_stop(void);
+
+/**
+@Function
+    unsigned char sim_drive(unsigned char port, unsigned short mask, unsigned short value)
+
+@Summary
+    The function sets the level applied from outside to the pins of
+    <code>mask</code>, as seen on the inputs.
+
+@Returns
+    1 if a Change Notification flag has been raised (a CNEN pin changed on a
+    port with CNCON ON), 0 otherwise.
+*/
+extern unsigned char sim_drive(unsigned char port, unsigned short mask, unsigned short value);
+
+/* Core Timer at CORE_TIMER_FREQ, from the host monotonic clock */
+extern unsigned int _CP0_GET_COUNT(void);
+
+/* Interrupt enable state: bit 0 of the returned status, as on the device */
+extern unsigned int sim_disable_interrupts(void);
+extern unsigned int sim_enable_interrupts(void);
+extern unsigned char sim_interrupts_enabled(void);
+#define __builtin_disable_interrupts() sim_disable_interrupts()
+#define __builtin_enable_interrupts() sim_enable_interrupts()
+#define _nop() ((void)0)
+
+#endif
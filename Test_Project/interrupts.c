@@ -0,0 +1,192 @@
+#include <xc.h>
+#include <sys/attribs.h>
+#include "interrupts.h"
+
+#define VECTOR_CN 0
+#define VECTOR_T1 1
+#define VECTOR_T2 2
+#define VECTOR_T3 3
+#define VECTOR_T4 4
+#define VECTOR_T5 5
+#define VECTOR_U1 6
+#define VECTORS   7
+
+const interrupt_source CN_A =   { &IFS1CLR, &IEC1CLR, &IEC1SET, 1 << 13, &IPC8CLR, &IPC8SET, 16, VECTOR_CN } ;
+const interrupt_source CN_B =   { &IFS1CLR, &IEC1CLR, &IEC1SET, 1 << 14, &IPC8CLR, &IPC8SET, 16, VECTOR_CN } ;
+#if IO_PORTS > 2
+const interrupt_source CN_C =   { &IFS1CLR, &IEC1CLR, &IEC1SET, 1 << 15, &IPC8CLR, &IPC8SET, 16, VECTOR_CN } ;
+#endif
+const interrupt_source TIMER1 = { &IFS0CLR, &IEC0CLR, &IEC0SET, 1 << 4,  &IPC1CLR, &IPC1SET, 0,  VECTOR_T1 } ;
+const interrupt_source TIMER2 = { &IFS0CLR, &IEC0CLR, &IEC0SET, 1 << 9,  &IPC2CLR, &IPC2SET, 0,  VECTOR_T2 } ;
+const interrupt_source TIMER3 = { &IFS0CLR, &IEC0CLR, &IEC0SET, 1 << 14, &IPC3CLR, &IPC3SET, 0,  VECTOR_T3 } ;
+const interrupt_source TIMER4 = { &IFS0CLR, &IEC0CLR, &IEC0SET, 1 << 19, &IPC4CLR, &IPC4SET, 0,  VECTOR_T4 } ;
+const interrupt_source TIMER5 = { &IFS0CLR, &IEC0CLR, &IEC0SET, 1 << 24, &IPC5CLR, &IPC5SET, 0,  VECTOR_T5 } ;
+const interrupt_source UART1_RX = { &IFS1CLR, &IEC1CLR, &IEC1SET, 1 << 8, &IPC8CLR, &IPC8SET, 0,  VECTOR_U1 } ;
+
+#if IO_PORTS > 2
+const interrupt_source *const change_notice[IO_PORTS] = { &CN_A, &CN_B, &CN_C } ;
+#else
+const interrupt_source *const change_notice[IO_PORTS] = { &CN_A, &CN_B } ;
+#endif
+
+/* The CN flags share the vector, so the handler acknowledges all at once */
+#if IO_PORTS > 2
+#define CN_FLAGS ((1 << 13) | (1 << 14) | (1 << 15))
+#else
+#define CN_FLAGS ((1 << 13) | (1 << 14))
+#endif
+
+static volatile interrupt_handler handlers[VECTORS];
+
+void interrupt_init(void){
+    INTCONSET = _INTCON_MVEC_MASK;
+    __builtin_enable_interrupts();
+}
+
+void interrupt_configure(const interrupt_source *src, unsigned char priority, unsigned char subpriority){
+    /* 5 bits field: subpriority<1:0>, priority<4:2> */
+    *(src->ipc_clr) = 0x1F << src->ipc_shift;
+    *(src->ipc_set) = (((priority & 7) << 2) | (subpriority & 3)) << src->ipc_shift;
+}
+
+inline void interrupt_enable(const interrupt_source *src, unsigned char activated){
+    if(activated == ON){
+        *(src->ifs_clr) = src->mask;
+        *(src->iec_set) = src->mask;
+    }
+    else *(src->iec_clr) = src->mask;
+}
+
+inline void interrupt_clear_flag(const interrupt_source *src){
+    *(src->ifs_clr) = src->mask;
+}
+
+inline unsigned char interrupt_pending(const interrupt_source *src){
+    /* IFSx is the word before its CLR alias */
+    return (*(src->ifs_clr - 1) & src->mask) != 0;
+}
+
+unsigned char interrupt_attach(const interrupt_source *src, interrupt_handler handler){
+    interrupt_handler owner = handlers[src->vector];
+    /* The CN vector is shared by every port: one owner, detach to hand over */
+    if(src->vector == VECTOR_CN && handler != NULL && owner != NULL && owner != handler) return 0;
+    handlers[src->vector] = handler;
+    return 1;
+}
+
+/*
+ * The CN vector runs on the shadow register set: the prologue only saves
+ * EPC/Status, and the indirect call does not force any GPR on the stack.
+ * PORTx must be read by the handler before the flag is cleared, otherwise
+ * the mismatch condition would raise the flag again; without a handler the
+ * vector reads every port itself.
+ */
+void __ISR(_CHANGE_NOTICE_VECTOR, CN_INTERRUPT_IPL) change_notice_vector(void){
+    interrupt_handler h = handlers[VECTOR_CN];
+    unsigned char p;
+    if(h != NULL) h();
+    else /* Nobody read PORTx: end the mismatch here, or the vector re-enters forever */
+        for(p = 0; p < IO_PORTS; p++) (void)*IO_REG(port_table[p], IO_PORT);
+    IFS1CLR = CN_FLAGS;
+}
+
+void __ISR(_TIMER_1_VECTOR, TIMER_INTERRUPT_IPL) timer1_vector(void){
+    interrupt_handler h = handlers[VECTOR_T1];
+    if(h != NULL) h();
+    IFS0CLR = TIMER1.mask;
+}
+
+void __ISR(_TIMER_2_VECTOR, TIMER_INTERRUPT_IPL) timer2_vector(void){
+    interrupt_handler h = handlers[VECTOR_T2];
+    if(h != NULL) h();
+    IFS0CLR = TIMER2.mask;
+}
+
+void __ISR(_TIMER_3_VECTOR, TIMER_INTERRUPT_IPL) timer3_vector(void){
+    interrupt_handler h = handlers[VECTOR_T3];
+    if(h != NULL) h();
+    IFS0CLR = TIMER3.mask;
+}
+
+void __ISR(_TIMER_4_VECTOR, TIMER_INTERRUPT_IPL) timer4_vector(void){
+    interrupt_handler h = handlers[VECTOR_T4];
+    if(h != NULL) h();
+    IFS0CLR = TIMER4.mask;
+}
+
+void __ISR(_TIMER_5_VECTOR, TIMER_INTERRUPT_IPL) timer5_vector(void){
+    interrupt_handler h = handlers[VECTOR_T5];
+    if(h != NULL) h();
+    IFS0CLR = TIMER5.mask;
+}
+
+/*
+ * The receive flag is raised again as long as the FIFO holds data: the
+ * handler must drain U1RXREG before the flag is acknowledged.
+ */
+void __ISR(_UART_1_VECTOR, UART_INTERRUPT_IPL) uart1_vector(void){
+    interrupt_handler h = handlers[VECTOR_U1];
+    if(h != NULL) h();
+    IFS1CLR = UART1_RX.mask;
+}
+
+/*
+ * Latency probe. Registers and masks are cached in plain variables so the
+ * handler does not chase the pin/io_port pointers on the critical path.
+ */
+static volatile unsigned int *probe_port;
+static volatile unsigned int *probe_set;
+static volatile unsigned int *probe_clr;
+static unsigned int probe_sense_mask;
+static unsigned int probe_response_mask;
+static volatile unsigned int probe_stamp;
+static volatile unsigned char probe_fired;
+
+static void latency_probe(void){
+    if(*probe_port & probe_sense_mask) *probe_set = probe_response_mask;
+    else *probe_clr = probe_response_mask;
+    probe_stamp = _CP0_GET_COUNT();
+    probe_fired = 1;
+}
+
+unsigned char interrupt_measure_cn_latency(const pin *stimulus, const pin *sense, const pin *response, unsigned int samples, latency_report *report){
+    interrupt_handler previous = handlers[VECTOR_CN];
+    unsigned int i, start, ticks, overhead, total = 0;
+    unsigned int min = 0xFFFFFFFF, max = 0;
+    unsigned char ok = 1;
+
+    probe_port = IO_REG(sense->io, IO_PORT);
+    probe_set = IO_REG(response->io, IO_PORT + IO_SET);
+    probe_clr = IO_REG(response->io, IO_PORT + IO_CLR);
+    probe_sense_mask = sense->mask;
+    probe_response_mask = response->mask;
+
+    /* Cost of two back-to-back reads of the Core Timer */
+    start = _CP0_GET_COUNT();
+    overhead = _CP0_GET_COUNT() - start;
+
+    handlers[VECTOR_CN] = latency_probe;
+    for(i = 0; i < samples && ok; i++){
+        probe_fired = 0;
+        start = _CP0_GET_COUNT();
+        *IO_REG(stimulus->io, IO_PORT + IO_INV) = stimulus->mask;
+        while(!probe_fired)
+            if(_CP0_GET_COUNT() - start > CORE_TIMER_FREQ / 1000){
+                ok = 0;
+                break;
+            }
+        if(!ok) break;
+        ticks = probe_stamp - start - overhead;
+        if(ticks < min) min = ticks;
+        if(ticks > max) max = ticks;
+        total += ticks;
+    }
+    handlers[VECTOR_CN] = previous;
+
+    report->samples = i;
+    if(i == 0) i = 1;
+    report->min_ns = min == 0xFFFFFFFF ? 0 : min * (1000000000UL / CORE_TIMER_FREQ);
+    report->max_ns = max * (1000000000UL / CORE_TIMER_FREQ);
+    report->avg_ns = (total / i) * (1000000000UL / CORE_TIMER_FREQ);
+    return ok;
+}
@@ -0,0 +1,314 @@
+#ifndef _INTERRUPTS_H
+#define _INTERRUPTS_H
+
+#include "digital_io.h"
+
+/**
+ @Summary
+    System clock frequency in Hz, used for every time computation of the library
+ @Remarks
+    Defaults to 40 MHz, the FRCPLL configuration of <code>main.c</code>
+    (8 MHz / 2 x 20 / 2). Override it from the project settings when the
+    oscillator configuration changes; <code>main.c</code> refuses to build
+    when the two disagree.
+ */
+#ifndef SYS_FREQ
+#define SYS_FREQ 40000000UL
+#endif
+
+/**
+ @Summary
+    Core Timer frequency in Hz. The CP0 Count register increments every two
+    SYSCLK cycles.
+ */
+#define CORE_TIMER_FREQ (SYS_FREQ / 2)
+
+/**
+ @Summary
+    Priority level reserved to the Change Notification vector
+ @Description
+    On the PIC32MX1xx/2xx family the only shadow register set is bound to
+    priority level 7 when the controller runs in multi-vector mode, so the
+    Change Notification vector sits at IPL7 and its handler is declared
+    <code>IPL7SRS</code>: no general purpose register is pushed on entry.
+ */
+#define CN_INTERRUPT_PRIORITY 7
+#define CN_INTERRUPT_IPL IPL7SRS
+
+/**
+ @Summary
+    Default priority for the timer vectors. They are preempted by the
+    Change Notification vector and use the software (stack) context save.
+ */
+#ifndef TIMER_INTERRUPT_PRIORITY
+#define TIMER_INTERRUPT_PRIORITY 4
+#endif
+#ifndef TIMER_INTERRUPT_IPL
+#define TIMER_INTERRUPT_IPL IPL4SOFT
+#endif
+
+/**
+ @Summary
+    Default priority for the UART receive vector, below the timers: the
+    4-deep receive FIFO gives it a few character times of slack.
+ */
+#ifndef UART_INTERRUPT_PRIORITY
+#define UART_INTERRUPT_PRIORITY 3
+#endif
+#ifndef UART_INTERRUPT_IPL
+#define UART_INTERRUPT_IPL IPL3SOFT
+#endif
+
+/**
+ @Summary
+    The struct represents an interrupt source of the MCU
+ @Description
+    As for io_port, every interrupt source is described by the pointers to the
+    registers that control it. All the pointers target the atomic CLR/SET
+    aliases, so that enabling, disabling or acknowledging a source is a single
+    store and never a read-modify-write of a register shared with other sources.
+ @Remarks
+    Follows the description of every field of the struct.
+    <ul>
+        <li><code>volatile unsigned int *ifs_clr</code> : pointer to the IFSxCLR register</li>
+        <li><code>volatile unsigned int *iec_clr</code> : pointer to the IECxCLR register</li>
+        <li><code>volatile unsigned int *iec_set</code> : pointer to the IECxSET register</li>
+        <li><code>const unsigned int mask</code> : bit of the source inside IFSx/IECx</li>
+        <li><code>volatile unsigned int *ipc_clr</code> : pointer to the IPCxCLR register</li>
+        <li><code>volatile unsigned int *ipc_set</code> : pointer to the IPCxSET register</li>
+        <li><code>const unsigned char ipc_shift</code> : position of the subpriority field
+            inside IPCx; the priority field follows it at <code>ipc_shift + 2</code></li>
+        <li><code>const unsigned char vector</code> : index of the library vector
+            dispatching the source, used to attach handlers</li>
+    </ul>
+ */
+typedef struct{
+    volatile unsigned int *ifs_clr;
+    volatile unsigned int *iec_clr;
+    volatile unsigned int *iec_set;
+    const unsigned int mask;
+    volatile unsigned int *ipc_clr;
+    volatile unsigned int *ipc_set;
+    const unsigned char ipc_shift;
+    const unsigned char vector;
+} interrupt_source;
+
+/**
+ @Summary
+    Signature of the handlers attached to a vector
+ */
+typedef void (*interrupt_handler)(void);
+
+/**
+ @Summary
+    Result of <code>interrupt_measure_cn_latency</code>, in nanoseconds
+ */
+typedef struct{
+    unsigned int min_ns;
+    unsigned int max_ns;
+    unsigned int avg_ns;
+    unsigned int samples;
+} latency_report;
+
+extern const interrupt_source CN_A;
+extern const interrupt_source CN_B;
+#if IO_PORTS > 2
+extern const interrupt_source CN_C;
+#endif
+
+/**
+ @Summary
+    Change notice source of each port, by <code>io_port.index</code>
+ */
+extern const interrupt_source *const change_notice[IO_PORTS];
+
+extern const interrupt_source TIMER1;
+extern const interrupt_source TIMER2;
+extern const interrupt_source TIMER3;
+extern const interrupt_source TIMER4;
+extern const interrupt_source TIMER5;
+extern const interrupt_source UART1_RX;
+
+/**
+@Function
+    void interrupt_init(void)
+
+@Summary
+    The function switches the interrupt controller to multi-vector mode and
+    enables interrupts globally.
+
+@Description
+    The function interacts with INTCON register. Multi-vector mode lets every
+    source jump straight to its own handler, which is the precondition for the
+    shadow register set to be used on the Change Notification vector.
+
+@Precondition
+    Every source should be configured with <code>interrupt_configure</code>
+    before calling this function.
+
+@Example
+    @code
+    interrupt_configure(&CN_B, CN_INTERRUPT_PRIORITY, 0);
+    interrupt_init();
+*/
+extern void interrupt_init(void);
+
+/**
+@Function
+    void interrupt_configure(const interrupt_source *src, unsigned char priority, unsigned char subpriority)
+
+@Summary
+    The function sets priority and subpriority of the given interrupt source.
+
+@Description
+    The function interacts with IPCx register through its CLR/SET aliases.
+    Sources sharing a vector (CN_A, CN_B, CN_C) share the same IPC field too.
+
+@Precondition
+    None.
+
+@Parameters
+    @param src A <code>const *interrupt_source</code> from the available ones
+    @param priority the priority level, 1 (lowest) to 7 (highest). 0 disables the vector
+    @param subpriority the subpriority level, 0 to 3
+
+@Remarks
+    The priority must match the IPL of the handler declaration, otherwise the
+    prologue of the handler will be wrong. Use <code>CN_INTERRUPT_PRIORITY</code>,
+    <code>TIMER_INTERRUPT_PRIORITY</code> and <code>UART_INTERRUPT_PRIORITY</code>.
+
+@Example
+    @code
+    interrupt_configure(&TIMER2, TIMER_INTERRUPT_PRIORITY, 1);
+*/
+extern void interrupt_configure(const interrupt_source *src, unsigned char priority, unsigned char subpriority);
+
+/**
+@Function
+    inline void interrupt_enable(const interrupt_source *src, unsigned char activated)
+
+@Summary
+    The function turns ON or OFF the given interrupt source.
+
+@Description
+    The pending flag is cleared before the source is enabled, so a stale event
+    does not fire the handler. Interacts with IFSxCLR, IECxSET and IECxCLR.
+
+@Parameters
+    @param src A <code>const *interrupt_source</code> from the available ones
+    @param activated ON or OFF
+
+@Example
+    @code
+    interrupt_enable(&CN_B, ON);
+*/
+extern inline void interrupt_enable(const interrupt_source *src, unsigned char activated);
+
+/**
+@Function
+    inline void interrupt_clear_flag(const interrupt_source *src)
+
+@Summary
+    The function acknowledges a pending interrupt of the given source.
+*/
+extern inline void interrupt_clear_flag(const interrupt_source *src);
+
+/**
+@Function
+    inline unsigned char interrupt_pending(const interrupt_source *src)
+
+@Summary
+    The function returns 1 if the flag of the given source is raised, enabled
+    or not.
+
+@Remarks
+    Useful with interrupts masked, to account for an event whose handler has
+    not run yet.
+*/
+extern inline unsigned char interrupt_pending(const interrupt_source *src);
+
+/**
+@Function
+    unsigned char interrupt_attach(const interrupt_source *src, interrupt_handler handler)
+
+@Summary
+    The function attaches a handler to the vector of the given source.
+
+@Description
+    The library owns the Change Notification, timer and UART1 receive vectors and dispatches
+    them to the attached handlers. The vector acknowledges the flag after the
+    handler returns, so the handler only has to do its own work.
+    For the Change Notification vector the handler is called on the shadow
+    register set: keep it short and let it read PORTx once.
+
+@Parameters
+    @param src A <code>const *interrupt_source</code> from the available ones
+    @param handler the function to call, NULL to detach
+
+@Returns
+<ul>
+    <li><code>1</code> if the handler has been attached</li>
+    <li><code>0</code> if <code>src</code> is a Change Notification source and
+        another handler already owns the vector</li>
+</ul>
+
+@Remarks
+    CN_A, CN_B and CN_C share the same vector, so they share the same handler:
+    the first module to attach owns it until it detaches with NULL. To run
+    several modules on Change Notification, attach one function calling each
+    of their handlers; together they must read every port whose Change
+    Notification is enabled, or the mismatch raises the flag again. Timer and
+    UART vectors belong to one source each and are simply replaced.
+
+@Example
+    @code
+    void on_change(void){ ... }
+    if(!interrupt_attach(&CN_B, on_change)) ...; //vector taken by another module
+*/
+extern unsigned char interrupt_attach(const interrupt_source *src, interrupt_handler handler);
+
+/**
+@Function
+    unsigned char interrupt_measure_cn_latency(const pin *stimulus, const pin *sense, const pin *response, unsigned int samples, latency_report *report)
+
+@Summary
+    The function measures the time between an edge on a pin and the output
+    write done by the Change Notification handler.
+
+@Description
+    <code>stimulus</code> must be wired to <code>sense</code> (in the
+    <code>main.c</code> setup, RA4 looped back on RB1). The function toggles
+    <code>stimulus</code>, the Change Notification handler mirrors
+    <code>sense</code> on <code>response</code> and stamps the Core Timer right
+    after the write. The difference against the stamp taken at the stimulus
+    write, minus the cost of the stamping itself, is the reaction latency.
+    The resolution is two SYSCLK cycles (50 ns at 40 MHz).
+
+@Precondition
+    <code>stimulus</code> and <code>response</code> set as OUTPUT, <code>sense</code>
+    as INPUT with Interrupt On Change active, and the Change Notification source
+    of its port configured, enabled and running (<code>interrupt_init</code>).
+    Any handler attached to the Change Notification vector is replaced during
+    the measure and restored afterwards.
+
+@Parameters
+    @param stimulus pin driven by the benchmark
+    @param sense pin wired to <code>stimulus</code>, watched by Change Notification
+    @param response pin written by the handler
+    @param samples number of edges to measure
+    @param report filled with min/max/average latency in nanoseconds
+
+@Returns
+<ul>
+    <li><code>1</code> if every edge has been caught</li>
+    <li><code>0</code> if the handler did not fire within 1 ms (loopback missing)</li>
+</ul>
+
+@Example
+    @code
+    latency_report r;
+    interrupt_measure_cn_latency(&RA4, &RB1, &RB2, 1000, &r); //r.avg_ns below 1000 at 40 MHz
+*/
+extern unsigned char interrupt_measure_cn_latency(const pin *stimulus, const pin *sense, const pin *response, unsigned int samples, latency_report *report);
+
+#endif
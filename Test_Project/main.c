@@ -4,12 +4,12 @@
 #pragma config IOL1WAY = OFF            /* Peripheral Pin Select Configuration (Allow multiple reconfigurations) */
 
 /* DEVCFG2 */
-#pragma config FPLLIDIV = DIV_1         /* PLL Input Divider (1x Divider) */
-#pragma config FPLLMUL = MUL_24         /* PLL Multiplier (24x Multiplier) */
-#pragma config FPLLODIV = DIV_1         /* System PLL Output Clock Divider (PLL Divide by 1) */
+#pragma config FPLLIDIV = DIV_2         /* PLL Input Divider (2x Divider) */
+#pragma config FPLLMUL = MUL_20         /* PLL Multiplier (20x Multiplier) */
+#pragma config FPLLODIV = DIV_2         /* System PLL Output Clock Divider (PLL Divide by 2) */
 
 /* DEVCFG1 */
-#pragma config FNOSC = FRC              /* Oscillator Selection Bits (Fast RC Osc (FRC)) */
+#pragma config FNOSC = FRCPLL           /* Oscillator Selection Bits (Fast RC Osc with PLL) */
 #pragma config FSOSCEN = OFF            /* Secondary Oscillator Enable (Disabled) */
 #pragma config IESO = OFF               /* Internal/External Switch Over (Disabled) */
 #pragma config POSCMOD = HS             /* Primary Oscillator Configuration (HS osc mode) */
@@ -30,21 +30,107 @@
 
 #include <xc.h>
 #include "digital_io.h"
+#include "timers.h"
+#include "rules.h"
+#include "interrupts.h"
+#include "uart.h"
 
-int main(void){
-    pin_set_direction(&RB1, INPUT);
+/*
+ * 1 builds the Change Notification latency benchmark instead of the pin and
+ * rules demo (-DMAIN_CN_LATENCY_BENCH=1). Wiring: RA4 looped back on RB1.
+ * The benchmark toggles RA4, the handler mirrors RB1 on RB2, and the result
+ * is kept in cn_latency (watch it from the debugger) and printed on U1TX
+ * (RB7, 115200 baud) as "@CNLAT samples min avg max" in nanoseconds.
+ * cn_latency_done is 1 once measured, 2 if the loopback is missing.
+ */
+#ifndef MAIN_CN_LATENCY_BENCH
+#define MAIN_CN_LATENCY_BENCH 0
+#endif
+#define CN_LATENCY_SAMPLES 1000
+
+/*
+ * The clock the pragmas above configure: 8 MHz FRC / 2 = 4 MHz PLL input
+ * (4..5 MHz allowed), x 20 = 80 MHz VCO, / 2 = 40 MHz SYSCLK, / 8 = PBCLK.
+ * Keep these in step with the pragmas: every delay, baud rate and period
+ * of the library is computed from SYS_FREQ and PB_DIV.
+ */
+#define OSC_FRC_FREQ 8000000UL
+#define OSC_PLL_IDIV 2
+#define OSC_PLL_MUL 20
+#define OSC_PLL_ODIV 2
+#define OSC_PB_DIV 8
+
+#if SYS_FREQ != OSC_FRC_FREQ / OSC_PLL_IDIV * OSC_PLL_MUL / OSC_PLL_ODIV
+#error "SYS_FREQ does not match the FNOSC/FPLL configuration of main.c"
+#endif
+#if PB_DIV != OSC_PB_DIV
+#error "PB_DIV does not match the FPBDIV configuration of main.c"
+#endif
+
+#if MAIN_CN_LATENCY_BENCH
+volatile latency_report cn_latency;
+volatile unsigned char cn_latency_done;
+
+static unsigned int put_decimal(unsigned char *line, unsigned int n, unsigned int value){
+    unsigned char digits[10];
+    unsigned int i = 0;
+    do{
+        digits[i++] = '0' + value % 10;
+        value /= 10;
+    }while(value != 0);
+    line[n++] = ' ';
+    while(i != 0) line[n++] = digits[--i];
+    return n;
+}
+
+static void cn_latency_bench(void){
+    latency_report r;
+    static const char prefix[] = "@CNLAT";
+    unsigned char line[64];
+    unsigned int n;
+
+    pin_select_working_mode(&RA4, DIGITAL);
     pin_set_direction(&RA4, OUTPUT);
+    pin_select_working_mode(&RB1, DIGITAL);
+    pin_set_direction(&RB1, INPUT);
+    pin_assign_interrupt_on_change(&RB1, ON);
+    pin_select_working_mode(&RB2, DIGITAL);
+    pin_set_direction(&RB2, OUTPUT);
+    port_set_change_notice_behaviour(&RB, ON, ON);
+    interrupt_configure(&CN_B, CN_INTERRUPT_PRIORITY, 0);
+    interrupt_enable(&CN_B, ON);
+    interrupt_init();
+
+    cn_latency_done = interrupt_measure_cn_latency(&RA4, &RB1, &RB2, CN_LATENCY_SAMPLES, &r) ? 1 : 2;
+    cn_latency = r;
+
+    if(!uart_init(&RB7, &RB13, 115200)) return;
+    for(n = 0; prefix[n] != '\0'; n++) line[n] = prefix[n];
+    n = put_decimal(line, n, r.samples);
+    n = put_decimal(line, n, r.min_ns);
+    n = put_decimal(line, n, r.avg_ns);
+    n = put_decimal(line, n, r.max_ns);
+    line[n++] = '\r';
+    line[n++] = '\n';
+    uart_write(line, n);
+}
+#endif
+
+int main(void){
+#if MAIN_CN_LATENCY_BENCH
+    cn_latency_bench();
+    while(1);
+#endif
     pin_open_drain_selection(&RB1, ON); /* Does nothing, RB1 not 5V Tolerant */
     pin_open_drain_selection(&RB5, ON);
     pin_select_working_mode(&RA3, ANALOGIC); /* Does not work, RA3 not AN port */
     pin_select_working_mode(&RA0, ANALOGIC);
     pin_assign_pull_up(&RB0, ON);
     pin_assign_pull_down(&RB2, ON);
-    pin_assign_interrupt_on_change(&RB1, ON);
     pin_assign_peripheral(&RA1, &INT4); /* Should do nothing because assignment is illegal */
     pin_assign_peripheral(&RB3, &INT4);   
-    while(1){
-        if(pin_read(&RB1) == HIGH) pin_set_output_high(&RA4);
-        else pin_set_output_low(&RA4);
-    }
+    rule_follow(&RA4, &RB1); /* Evaluated by the Change Notification handler */
+    rules_start();
+    interrupt_init();
+    while(1);
 }
\ No newline at end of file
@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=digital_io.c main.c
+SOURCEFILES_QUOTED_IF_SPACED=digital_io.c main.c interrupts.c encoder.c timers.c scan.c parallel_bus.c bitbang.c uart.c remote_protocol.c remote_gpio.c refclk.c device_28pin.c device_44pin.c rules.c profile.c counter.c profiler.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/digital_io.o ${OBJECTDIR}/main.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/digital_io.o.d ${OBJECTDIR}/main.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/digital_io.o ${OBJECTDIR}/main.o ${OBJECTDIR}/interrupts.o ${OBJECTDIR}/encoder.o ${OBJECTDIR}/timers.o ${OBJECTDIR}/scan.o ${OBJECTDIR}/parallel_bus.o ${OBJECTDIR}/bitbang.o ${OBJECTDIR}/uart.o ${OBJECTDIR}/remote_protocol.o ${OBJECTDIR}/remote_gpio.o ${OBJECTDIR}/refclk.o ${OBJECTDIR}/device_28pin.o ${OBJECTDIR}/device_44pin.o ${OBJECTDIR}/rules.o ${OBJECTDIR}/profile.o ${OBJECTDIR}/counter.o ${OBJECTDIR}/profiler.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/digital_io.o.d ${OBJECTDIR}/main.o.d ${OBJECTDIR}/interrupts.o.d ${OBJECTDIR}/encoder.o.d ${OBJECTDIR}/timers.o.d ${OBJECTDIR}/scan.o.d ${OBJECTDIR}/parallel_bus.o.d ${OBJECTDIR}/bitbang.o.d ${OBJECTDIR}/uart.o.d ${OBJECTDIR}/remote_protocol.o.d ${OBJECTDIR}/remote_gpio.o.d ${OBJECTDIR}/refclk.o.d ${OBJECTDIR}/device_28pin.o.d ${OBJECTDIR}/device_44pin.o.d ${OBJECTDIR}/rules.o.d ${OBJECTDIR}/profile.o.d ${OBJECTDIR}/counter.o.d ${OBJECTDIR}/profiler.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/digital_io.o ${OBJECTDIR}/main.o
+OBJECTFILES=${OBJECTDIR}/digital_io.o ${OBJECTDIR}/main.o ${OBJECTDIR}/interrupts.o ${OBJECTDIR}/encoder.o ${OBJECTDIR}/timers.o ${OBJECTDIR}/scan.o ${OBJECTDIR}/parallel_bus.o ${OBJECTDIR}/bitbang.o ${OBJECTDIR}/uart.o ${OBJECTDIR}/remote_protocol.o ${OBJECTDIR}/remote_gpio.o ${OBJECTDIR}/refclk.o ${OBJECTDIR}/device_28pin.o ${OBJECTDIR}/device_44pin.o ${OBJECTDIR}/rules.o ${OBJECTDIR}/profile.o ${OBJECTDIR}/counter.o ${OBJECTDIR}/profiler.o
 
 # Source Files
-SOURCEFILES=digital_io.c main.c
+SOURCEFILES=digital_io.c main.c interrupts.c encoder.c timers.c scan.c parallel_bus.c bitbang.c uart.c remote_protocol.c remote_gpio.c refclk.c device_28pin.c device_44pin.c rules.c profile.c counter.c profiler.c
 
 
 CFLAGS=
@@ -118,6 +118,102 @@ ${OBJECTDIR}/main.o: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/main.o 
 	@${FIXDEPS} "${OBJECTDIR}/main.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/main.o.d" -o ${OBJECTDIR}/main.o main.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
 	
+${OBJECTDIR}/profiler.o: profiler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/profiler.o.d 
+	@${RM} ${OBJECTDIR}/profiler.o 
+	@${FIXDEPS} "${OBJECTDIR}/profiler.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/profiler.o.d" -o ${OBJECTDIR}/profiler.o profiler.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/counter.o: counter.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/counter.o.d 
+	@${RM} ${OBJECTDIR}/counter.o 
+	@${FIXDEPS} "${OBJECTDIR}/counter.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/counter.o.d" -o ${OBJECTDIR}/counter.o counter.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/profile.o: profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/profile.o.d 
+	@${RM} ${OBJECTDIR}/profile.o 
+	@${FIXDEPS} "${OBJECTDIR}/profile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/profile.o.d" -o ${OBJECTDIR}/profile.o profile.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/rules.o: rules.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/rules.o.d 
+	@${RM} ${OBJECTDIR}/rules.o 
+	@${FIXDEPS} "${OBJECTDIR}/rules.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/rules.o.d" -o ${OBJECTDIR}/rules.o rules.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/device_44pin.o: device_44pin.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/device_44pin.o.d 
+	@${RM} ${OBJECTDIR}/device_44pin.o 
+	@${FIXDEPS} "${OBJECTDIR}/device_44pin.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/device_44pin.o.d" -o ${OBJECTDIR}/device_44pin.o device_44pin.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/device_28pin.o: device_28pin.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/device_28pin.o.d 
+	@${RM} ${OBJECTDIR}/device_28pin.o 
+	@${FIXDEPS} "${OBJECTDIR}/device_28pin.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/device_28pin.o.d" -o ${OBJECTDIR}/device_28pin.o device_28pin.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/refclk.o: refclk.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/refclk.o.d 
+	@${RM} ${OBJECTDIR}/refclk.o 
+	@${FIXDEPS} "${OBJECTDIR}/refclk.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/refclk.o.d" -o ${OBJECTDIR}/refclk.o refclk.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/remote_gpio.o: remote_gpio.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/remote_gpio.o.d 
+	@${RM} ${OBJECTDIR}/remote_gpio.o 
+	@${FIXDEPS} "${OBJECTDIR}/remote_gpio.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/remote_gpio.o.d" -o ${OBJECTDIR}/remote_gpio.o remote_gpio.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/remote_protocol.o: remote_protocol.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/remote_protocol.o.d 
+	@${RM} ${OBJECTDIR}/remote_protocol.o 
+	@${FIXDEPS} "${OBJECTDIR}/remote_protocol.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/remote_protocol.o.d" -o ${OBJECTDIR}/remote_protocol.o remote_protocol.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/uart.o: uart.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/uart.o.d 
+	@${RM} ${OBJECTDIR}/uart.o 
+	@${FIXDEPS} "${OBJECTDIR}/uart.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/uart.o.d" -o ${OBJECTDIR}/uart.o uart.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/bitbang.o: bitbang.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/bitbang.o.d 
+	@${RM} ${OBJECTDIR}/bitbang.o 
+	@${FIXDEPS} "${OBJECTDIR}/bitbang.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/bitbang.o.d" -o ${OBJECTDIR}/bitbang.o bitbang.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/parallel_bus.o: parallel_bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/parallel_bus.o.d 
+	@${RM} ${OBJECTDIR}/parallel_bus.o 
+	@${FIXDEPS} "${OBJECTDIR}/parallel_bus.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/parallel_bus.o.d" -o ${OBJECTDIR}/parallel_bus.o parallel_bus.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/scan.o: scan.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/scan.o.d 
+	@${RM} ${OBJECTDIR}/scan.o 
+	@${FIXDEPS} "${OBJECTDIR}/scan.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/scan.o.d" -o ${OBJECTDIR}/scan.o scan.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/timers.o: timers.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/timers.o.d 
+	@${RM} ${OBJECTDIR}/timers.o 
+	@${FIXDEPS} "${OBJECTDIR}/timers.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/timers.o.d" -o ${OBJECTDIR}/timers.o timers.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/encoder.o: encoder.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/encoder.o.d 
+	@${RM} ${OBJECTDIR}/encoder.o 
+	@${FIXDEPS} "${OBJECTDIR}/encoder.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/encoder.o.d" -o ${OBJECTDIR}/encoder.o encoder.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/interrupts.o: interrupts.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/interrupts.o.d 
+	@${RM} ${OBJECTDIR}/interrupts.o 
+	@${FIXDEPS} "${OBJECTDIR}/interrupts.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG -DSimulator=1  -fframe-base-loclist  -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/interrupts.o.d" -o ${OBJECTDIR}/interrupts.o interrupts.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
 else
 ${OBJECTDIR}/digital_io.o: digital_io.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}" 
@@ -131,6 +227,102 @@ ${OBJECTDIR}/main.o: main.c  nbproject/Makefile-${CND_CONF}.mk
 	@${RM} ${OBJECTDIR}/main.o 
 	@${FIXDEPS} "${OBJECTDIR}/main.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/main.o.d" -o ${OBJECTDIR}/main.o main.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
 	
+${OBJECTDIR}/profiler.o: profiler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/profiler.o.d 
+	@${RM} ${OBJECTDIR}/profiler.o 
+	@${FIXDEPS} "${OBJECTDIR}/profiler.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/profiler.o.d" -o ${OBJECTDIR}/profiler.o profiler.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/counter.o: counter.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/counter.o.d 
+	@${RM} ${OBJECTDIR}/counter.o 
+	@${FIXDEPS} "${OBJECTDIR}/counter.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/counter.o.d" -o ${OBJECTDIR}/counter.o counter.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/profile.o: profile.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/profile.o.d 
+	@${RM} ${OBJECTDIR}/profile.o 
+	@${FIXDEPS} "${OBJECTDIR}/profile.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/profile.o.d" -o ${OBJECTDIR}/profile.o profile.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/rules.o: rules.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/rules.o.d 
+	@${RM} ${OBJECTDIR}/rules.o 
+	@${FIXDEPS} "${OBJECTDIR}/rules.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/rules.o.d" -o ${OBJECTDIR}/rules.o rules.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/device_44pin.o: device_44pin.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/device_44pin.o.d 
+	@${RM} ${OBJECTDIR}/device_44pin.o 
+	@${FIXDEPS} "${OBJECTDIR}/device_44pin.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/device_44pin.o.d" -o ${OBJECTDIR}/device_44pin.o device_44pin.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/device_28pin.o: device_28pin.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/device_28pin.o.d 
+	@${RM} ${OBJECTDIR}/device_28pin.o 
+	@${FIXDEPS} "${OBJECTDIR}/device_28pin.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/device_28pin.o.d" -o ${OBJECTDIR}/device_28pin.o device_28pin.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/refclk.o: refclk.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/refclk.o.d 
+	@${RM} ${OBJECTDIR}/refclk.o 
+	@${FIXDEPS} "${OBJECTDIR}/refclk.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/refclk.o.d" -o ${OBJECTDIR}/refclk.o refclk.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/remote_gpio.o: remote_gpio.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/remote_gpio.o.d 
+	@${RM} ${OBJECTDIR}/remote_gpio.o 
+	@${FIXDEPS} "${OBJECTDIR}/remote_gpio.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/remote_gpio.o.d" -o ${OBJECTDIR}/remote_gpio.o remote_gpio.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/remote_protocol.o: remote_protocol.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/remote_protocol.o.d 
+	@${RM} ${OBJECTDIR}/remote_protocol.o 
+	@${FIXDEPS} "${OBJECTDIR}/remote_protocol.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/remote_protocol.o.d" -o ${OBJECTDIR}/remote_protocol.o remote_protocol.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/uart.o: uart.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/uart.o.d 
+	@${RM} ${OBJECTDIR}/uart.o 
+	@${FIXDEPS} "${OBJECTDIR}/uart.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/uart.o.d" -o ${OBJECTDIR}/uart.o uart.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/bitbang.o: bitbang.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/bitbang.o.d 
+	@${RM} ${OBJECTDIR}/bitbang.o 
+	@${FIXDEPS} "${OBJECTDIR}/bitbang.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/bitbang.o.d" -o ${OBJECTDIR}/bitbang.o bitbang.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/parallel_bus.o: parallel_bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/parallel_bus.o.d 
+	@${RM} ${OBJECTDIR}/parallel_bus.o 
+	@${FIXDEPS} "${OBJECTDIR}/parallel_bus.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/parallel_bus.o.d" -o ${OBJECTDIR}/parallel_bus.o parallel_bus.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/scan.o: scan.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/scan.o.d 
+	@${RM} ${OBJECTDIR}/scan.o 
+	@${FIXDEPS} "${OBJECTDIR}/scan.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/scan.o.d" -o ${OBJECTDIR}/scan.o scan.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/timers.o: timers.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/timers.o.d 
+	@${RM} ${OBJECTDIR}/timers.o 
+	@${FIXDEPS} "${OBJECTDIR}/timers.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/timers.o.d" -o ${OBJECTDIR}/timers.o timers.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/encoder.o: encoder.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/encoder.o.d 
+	@${RM} ${OBJECTDIR}/encoder.o 
+	@${FIXDEPS} "${OBJECTDIR}/encoder.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/encoder.o.d" -o ${OBJECTDIR}/encoder.o encoder.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
+${OBJECTDIR}/interrupts.o: interrupts.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/interrupts.o.d 
+	@${RM} ${OBJECTDIR}/interrupts.o 
+	@${FIXDEPS} "${OBJECTDIR}/interrupts.o.d" $(SILENT) -rsi ${MP_CC_DIR}../  -c ${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -O1 -pedantic -mcci -MMD -MF "${OBJECTDIR}/interrupts.o.d" -o ${OBJECTDIR}/interrupts.o interrupts.c    -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD) 
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -0,0 +1,203 @@
+#include <xc.h>
+#include "parallel_bus.h"
+
+static volatile unsigned int *data_port;
+static volatile unsigned int *data_clr;
+static volatile unsigned int *data_set;
+static volatile unsigned int *data_tris_set;
+static volatile unsigned int *data_tris_clr;
+static unsigned int data_mask;
+static unsigned char width;
+
+/* Contiguous, in order pins: the byte is shifted instead of looked up */
+static unsigned char contiguous;
+static unsigned char shift;
+
+static unsigned short scatter_lo[256];
+#if PBUS_MAX_WIDTH > 8
+static unsigned short scatter_hi[256];
+#endif
+static unsigned short gather[4][16];
+
+static volatile unsigned int *wr_clr;
+static volatile unsigned int *wr_set;
+static unsigned int wr_mask;
+/* WR on the data port: its falling edge is merged in the data CLR store */
+static unsigned int wr_merged;
+
+static const pin *rd_pin;
+static const pin *dc_pin;
+
+/* PBUS_READ_DELAY_NS in Core Timer ticks, rounded up */
+#define READ_DELAY_TICKS ((unsigned int)(((unsigned long long)PBUS_READ_DELAY_NS * CORE_TIMER_FREQ + 999999999ULL) / 1000000000ULL))
+
+static unsigned char mask_to_bit(unsigned int mask){
+    unsigned char i = 0;
+    while(mask > 1){
+        mask >>= 1;
+        i++;
+    }
+    return i;
+}
+
+static inline unsigned int scatter(unsigned int value){
+    if(contiguous) return (value << shift) & data_mask;
+#if PBUS_MAX_WIDTH > 8
+    return scatter_lo[value & 0xFF] | scatter_hi[(value >> 8) & 0xFF];
+#else
+    return scatter_lo[value & 0xFF];
+#endif
+}
+
+unsigned char pbus_init(const pin_group *data, const pin *wr, const pin *rd, const pin *dc){
+    unsigned char i, bit;
+    unsigned int v;
+    const pin *p;
+    const io_port *io;
+    if((*data)[0] == PIN_NONE) return 0;
+    io = pin_table[(*data)[0]]->io;
+
+    data_mask = 0;
+    contiguous = 1;
+    shift = mask_to_bit(pin_table[(*data)[0]]->mask);
+    for(i = 0; i < 4; i++)
+        for(v = 0; v < 16; v++) gather[i][v] = 0;
+    for(i = 0; i < PIN_GROUP_SIZE && (*data)[i] != PIN_NONE; i++){
+        p = pin_table[(*data)[i]];
+        if(i == PBUS_MAX_WIDTH || p->io != io) return 0;
+        bit = mask_to_bit(p->mask);
+        if(bit != shift + i) contiguous = 0;
+        data_mask |= p->mask;
+        for(v = 0; v < 16; v++)
+            if(v & (1 << (bit & 3))) gather[bit >> 2][v] |= 1 << i;
+    }
+    width = i;
+
+    /* Bit n of the value goes to the n-th pin of the group */
+    for(v = 0; v < 256; v++){
+        scatter_lo[v] = 0;
+#if PBUS_MAX_WIDTH > 8
+        scatter_hi[v] = 0;
+#endif
+        for(i = 0; i < width; i++){
+            if(i < 8 && (v & (1 << i))) scatter_lo[v] |= pin_table[(*data)[i]]->mask;
+#if PBUS_MAX_WIDTH > 8
+            if(i >= 8 && (v & (1 << (i - 8)))) scatter_hi[v] |= pin_table[(*data)[i]]->mask;
+#endif
+        }
+    }
+
+    data_port = IO_REG(io, IO_PORT);
+    data_clr = IO_REG(io, IO_PORT + IO_CLR);
+    data_set = IO_REG(io, IO_PORT + IO_SET);
+    data_tris_set = IO_REG(io, IO_TRIS + IO_SET);
+    data_tris_clr = IO_REG(io, IO_TRIS + IO_CLR);
+    wr_clr = IO_REG(wr->io, IO_PORT + IO_CLR);
+    wr_set = IO_REG(wr->io, IO_PORT + IO_SET);
+    wr_mask = wr->mask;
+    wr_merged = (wr->io == io) ? wr_mask : 0;
+    rd_pin = rd;
+    dc_pin = dc;
+
+    pin_set_output_high(wr);
+    pin_set_direction(wr, OUTPUT);
+    if(rd != NULL){
+        pin_set_output_high(rd);
+        pin_set_direction(rd, OUTPUT);
+    }
+    if(dc != NULL){
+        pin_set_output_high(dc);
+        pin_set_direction(dc, OUTPUT);
+    }
+    for(i = 0; i < width; i++){
+        pin_select_working_mode(pin_table[(*data)[i]], DIGITAL);
+        pin_set_direction(pin_table[(*data)[i]], OUTPUT);
+    }
+    return 1;
+}
+
+void pbus_write(unsigned int value){
+    unsigned int word = scatter(value);
+    if(wr_merged){
+        *data_clr = (data_mask & ~word) | wr_merged;
+        *data_set = word;
+    }
+    else{
+        *data_clr = data_mask & ~word;
+        *data_set = word;
+        *wr_clr = wr_mask;
+    }
+    *wr_set = wr_mask;
+}
+
+void pbus_command(unsigned int value){
+    if(dc_pin != NULL) pin_set_output_low(dc_pin);
+    pbus_write(value);
+    if(dc_pin != NULL) pin_set_output_high(dc_pin);
+}
+
+void pbus_write_block(const unsigned char *data, unsigned int length){
+    volatile unsigned int *clr = data_clr, *set = data_set, *strobe = wr_set;
+    unsigned int mask = data_mask, strobe_mask = wr_mask, merged = wr_merged, word;
+    const unsigned char *end = data + length;
+
+    if(merged && contiguous){
+        while(data != end){
+            word = ((unsigned int)*data++ << shift) & mask;
+            *clr = (mask & ~word) | merged;
+            *set = word;
+            *strobe = strobe_mask;
+        }
+    }
+    else if(merged){
+        while(data != end){
+            word = scatter_lo[*data++];
+            *clr = (mask & ~word) | merged;
+            *set = word;
+            *strobe = strobe_mask;
+        }
+    }
+    else while(data != end) pbus_write(*data++);
+}
+
+void pbus_write_repeat(unsigned int value, unsigned int count){
+    if(count == 0) return;
+    pbus_write(value);
+    while(--count){
+        *wr_clr = wr_mask;
+        *wr_set = wr_mask;
+    }
+}
+
+unsigned int pbus_read(void){
+    unsigned int word;
+    if(rd_pin == NULL) return 0;
+    *data_tris_set = data_mask;
+    pin_set_output_low(rd_pin);
+#if PBUS_READ_DELAY_NS > 0
+    {
+        /* At least READ_DELAY_TICKS whole ticks, whatever the phase of Count */
+        unsigned int start = _CP0_GET_COUNT();
+        while(_CP0_GET_COUNT() - start <= READ_DELAY_TICKS);
+    }
+#endif
+    word = *data_port;
+    pin_set_output_high(rd_pin);
+    *data_tris_clr = data_mask;
+    if(contiguous) return (word & data_mask) >> shift;
+    return gather[0][word & 15] | gather[1][(word >> 4) & 15] | gather[2][(word >> 8) & 15] | gather[3][(word >> 12) & 15];
+}
+
+unsigned int pbus_measure_throughput(unsigned int length){
+    unsigned char pattern[64];
+    unsigned int i, chunk, start, ticks = 0;
+    for(i = 0; i < sizeof(pattern); i++) pattern[i] = (i & 1) ? (unsigned char)~i : (unsigned char)i;
+    for(i = 0; i < length; i += chunk){
+        chunk = (length - i) < sizeof(pattern) ? (length - i) : sizeof(pattern);
+        start = _CP0_GET_COUNT();
+        pbus_write_block(pattern, chunk);
+        ticks += _CP0_GET_COUNT() - start;
+    }
+    if(ticks == 0) return 0;
+    return (unsigned int)((unsigned long long)length * CORE_TIMER_FREQ / ticks);
+}
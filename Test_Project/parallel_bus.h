@@ -0,0 +1,146 @@
+#ifndef _PARALLEL_BUS_H
+#define _PARALLEL_BUS_H
+
+#include "digital_io.h"
+#include "interrupts.h"
+
+/**
+ @Summary
+    Widest data bus supported. With 8 only the low byte scatter table is
+    allocated (512 bytes of RAM); set it to 16 from the project settings to
+    allocate the high byte table too.
+ */
+#ifndef PBUS_MAX_WIDTH
+#define PBUS_MAX_WIDTH 8
+#endif
+
+/**
+ @Summary
+    Time from the RD falling edge to PORTx being sampled, in ns: the read
+    access time of the device plus the input synchronizer of the port. The
+    wait is rounded up to the Core Timer resolution (2 SYSCLK cycles); 0
+    samples right after the edge.
+ */
+#ifndef PBUS_READ_DELAY_NS
+#define PBUS_READ_DELAY_NS 100
+#endif
+
+/**
+@Function
+    unsigned char pbus_init(const pin_group *data, const pin *wr, const pin *rd, const pin *dc)
+
+@Summary
+    The function prepares an 8080-style parallel bus on the given pins.
+
+@Description
+    The n-th pin of <code>data</code> carries bit n of the bus. At init the
+    function builds the scatter tables mapping every byte to the word to store
+    in PORTxSET, and the nibble gather tables mapping PORTx back to a byte. When
+    the data pins are contiguous and in order on the port the tables are not
+    used at all: a write is a shift and a read is a shift and a mask.
+    A write is one lookup, one PORTxCLR and one PORTxSET store plus the WR
+    strobe; when WR sits on the data port its falling edge is merged in the
+    CLR store.
+
+@Precondition
+    None. Control pins are driven to their idle (HIGH) level.
+
+@Parameters
+    @param data <code>pin_group</code> of data pins, all on the same port
+    @param wr write strobe, latched on its rising edge
+    @param rd read strobe, NULL for write-only buses
+    @param dc data/command select (RS), NULL if not used
+
+@Returns
+<ul>
+    <li><code>1</code> if the bus has been configured</li>
+    <li><code>0</code> if the data pins span two ports or the bus is wider than
+        <code>PBUS_MAX_WIDTH</code></li>
+</ul>
+
+@Example
+    @code
+    const pin_group lcd_data = { PIN_RB0, PIN_RB1, PIN_RB2, PIN_RB3, PIN_RB4, PIN_RB5, PIN_RB7, PIN_RB8 };
+    pbus_init(&lcd_data, &RB9, &RB10, &RB11);
+    pbus_command(0x2C);
+    pbus_write_block(frame, sizeof(frame));
+*/
+extern unsigned char pbus_init(const pin_group *data, const pin *wr, const pin *rd, const pin *dc);
+
+/**
+@Function
+    void pbus_write(unsigned int value)
+
+@Summary
+    The function writes one word on the bus, with DC at its current level.
+*/
+extern void pbus_write(unsigned int value);
+
+/**
+@Function
+    void pbus_command(unsigned int value)
+
+@Summary
+    The function writes one word with DC LOW, then brings DC back HIGH.
+*/
+extern void pbus_command(unsigned int value);
+
+/**
+@Function
+    void pbus_write_block(const unsigned char *data, unsigned int length)
+
+@Summary
+    The function streams a block of bytes on the bus.
+
+@Description
+    The registers, masks and the table/fast path choice are resolved once for
+    the whole block, so the loop body is a lookup and three or four stores.
+*/
+extern void pbus_write_block(const unsigned char *data, unsigned int length);
+
+/**
+@Function
+    void pbus_write_repeat(unsigned int value, unsigned int count)
+
+@Summary
+    The function writes the same word <code>count</code> times. The data lines
+    are set once: only the strobe toggles, which is the fastest way to fill a
+    display area with a color.
+*/
+extern void pbus_write_repeat(unsigned int value, unsigned int count);
+
+/**
+@Function
+    unsigned int pbus_read(void)
+
+@Summary
+    The function reads one word from the bus.
+
+@Description
+    The data pins are turned to INPUT, RD is pulsed and PORTx is sampled
+    <code>PBUS_READ_DELAY_NS</code> after its falling edge, before the rising
+    one, then the data pins go back to OUTPUT. TRISx is written through its
+    SET/CLR aliases, so handlers driving other pins of the port are safe.
+
+@Returns
+    The word read, or 0 when the bus has no RD pin.
+*/
+extern unsigned int pbus_read(void);
+
+/**
+@Function
+    unsigned int pbus_measure_throughput(unsigned int length)
+
+@Summary
+    The function measures the streaming speed of the bus.
+
+@Description
+    <code>pbus_write_block</code> is timed with the Core Timer over
+    <code>length</code> bytes of a changing pattern, so every data line toggles.
+
+@Returns
+    The throughput in bytes per second.
+*/
+extern unsigned int pbus_measure_throughput(unsigned int length);
+
+#endif
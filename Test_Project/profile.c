@@ -0,0 +1,144 @@
+#include <xc.h>
+#include "profile.h"
+
+/* Input PPS registers, in the order of the nibbles of pin_profile.input_pps */
+static const peripheral *const inputs[PROFILE_INPUTS] = {
+    &INT1, &INT2, &INT3, &INT4, &T2CK, &T3CK, &T4CK, &T5CK,
+    &IC1, &IC2, &IC3, &IC4, &IC5, &REFCLKI, &U1CTS, &U1RX,
+    &U2CTS, &U2RX, &SDI1, &SS1, &SDI2, &SS2, &OCFA, &OCFB
+};
+
+static const pin_profile *active = NULL;
+
+void profile_capture(pin_profile *p){
+    unsigned char i, n;
+    const io_port *io;
+    const pin *q;
+    for(i = 0; i < IO_PORTS; i++){
+        io = port_table[i];
+        p->ansel[i] = *IO_REG(io, IO_ANSEL);
+        p->tris[i] = *IO_REG(io, IO_TRIS);
+        p->lat[i] = *IO_REG(io, IO_LAT);
+        p->odc[i] = *IO_REG(io, IO_ODC);
+        p->cnpu[i] = *IO_REG(io, IO_CNPU);
+        p->cnpd[i] = *IO_REG(io, IO_CNPD);
+        p->cnen[i] = *IO_REG(io, IO_CNEN);
+        p->rp[i][0] = p->rp[i][1] = 0;
+    }
+    for(i = PIN_NONE + 1; i < PIN_COUNT; i++){
+        q = pin_table[i];
+        if(q->pps_group == PPS_NO_GROUP) continue;
+        n = __builtin_ctz(q->mask);
+        p->rp[q->io->index][n >> 3] |= (*IO_RP(q->io, n) & 0xF) << ((n & 7) * 4);
+    }
+    for(i = 0; i < PROFILE_INPUT_WORDS; i++) p->input_pps[i] = 0;
+    for(i = 0; i < PROFILE_INPUTS; i++)
+        p->input_pps[i >> 3] |= (*(inputs[i]->input_pps) & 0xF) << ((i & 7) * 4);
+    active = p;
+}
+
+/* SET the bits of a register turning ON, on every port */
+static void turn_on(unsigned char reg, const unsigned short *from, const unsigned short *to){
+    unsigned char p;
+    unsigned short d;
+    for(p = 0; p < IO_PORTS; p++)
+        if((d = (from[p] ^ to[p]) & to[p]) != 0) *IO_REG(port_table[p], reg + IO_SET) = d;
+}
+
+/* CLR the bits of a register turning OFF, on every port */
+static void turn_off(unsigned char reg, const unsigned short *from, const unsigned short *to){
+    unsigned char p;
+    unsigned short d;
+    for(p = 0; p < IO_PORTS; p++)
+        if((d = (from[p] ^ to[p]) & from[p]) != 0) *IO_REG(port_table[p], reg + IO_CLR) = d;
+}
+
+/* Pins of a port whose TRIS, ANSEL, ODC or RPxnR source differ */
+static unsigned int role_changes(const pin_profile *from, const pin_profile *to, unsigned char p){
+    unsigned int m, d;
+    unsigned char w, n;
+    m = (from->tris[p] ^ to->tris[p]) | (from->ansel[p] ^ to->ansel[p]) | (from->odc[p] ^ to->odc[p]);
+    for(w = 0; w < 2; w++)
+        for(d = from->rp[p][w] ^ to->rp[p][w]; d != 0; d &= ~(0xFu << (n * 4))){
+            n = __builtin_ctz(d) >> 2;
+            m |= 1u << (w * 8 + n);
+        }
+    return m;
+}
+
+void profile_switch(const pin_profile *to){
+    const pin_profile *from = active;
+    unsigned char p, w, n;
+    unsigned int d, lat;
+
+    if(from == NULL || from == to) return;
+
+    turn_off(IO_CNEN, from->cnen, to->cnen);
+    turn_on(IO_CNPU, from->cnpu, to->cnpu);
+    turn_on(IO_CNPD, from->cnpd, to->cnpd);
+    turn_on(IO_TRIS, from->tris, to->tris);
+    turn_on(IO_ANSEL, from->ansel, to->ansel);
+    turn_off(IO_ANSEL, from->ansel, to->ansel);
+
+    for(w = 0; w < PROFILE_INPUT_WORDS; w++)
+        for(d = from->input_pps[w] ^ to->input_pps[w]; d != 0; d &= ~(0xFu << (n * 4))){
+            n = __builtin_ctz(d) >> 2;
+            *(inputs[w * 8 + n]->input_pps) = (to->input_pps[w] >> (n * 4)) & 0xF;
+        }
+
+    turn_on(IO_ODC, from->odc, to->odc);
+    turn_off(IO_ODC, from->odc, to->odc);
+    for(p = 0; p < IO_PORTS; p++){
+        /* Pins keeping their role and level keep the LAT driven since */
+        lat = role_changes(from, to, p) | (from->lat[p] ^ to->lat[p]);
+        if((d = lat & to->lat[p]) != 0) *IO_REG(port_table[p], IO_LAT + IO_SET) = d;
+        if((d = lat & ~to->lat[p]) != 0) *IO_REG(port_table[p], IO_LAT + IO_CLR) = d;
+    }
+
+    for(p = 0; p < IO_PORTS; p++)
+        for(w = 0; w < 2; w++)
+            for(d = from->rp[p][w] ^ to->rp[p][w]; d != 0; d &= ~(0xFu << (n * 4))){
+                n = __builtin_ctz(d) >> 2;
+                *IO_RP(port_table[p], w * 8 + n) = (to->rp[p][w] >> (n * 4)) & 0xF;
+            }
+
+    turn_off(IO_TRIS, from->tris, to->tris);
+    turn_off(IO_CNPU, from->cnpu, to->cnpu);
+    turn_off(IO_CNPD, from->cnpd, to->cnpd);
+    turn_on(IO_CNEN, from->cnen, to->cnen);
+    /* Reading PORTx resets the mismatch condition of the new CN pins */
+    for(p = 0; p < IO_PORTS; p++)
+        if((from->cnen[p] ^ to->cnen[p]) & to->cnen[p]) (void)*IO_REG(port_table[p], IO_PORT);
+    active = to;
+}
+
+const pin_profile *profile_active(void){
+    return active;
+}
+
+unsigned char profile_measure_switch(const pin_profile *a, const pin_profile *b, unsigned int samples, latency_report *report){
+    unsigned int i, start, ticks, overhead, total = 0;
+    unsigned int min = 0xFFFFFFFF, max = 0;
+    const pin_profile *next;
+
+    if(active == NULL || samples == 0) return 0;
+    /* Cost of two back-to-back reads of the Core Timer */
+    start = _CP0_GET_COUNT();
+    overhead = _CP0_GET_COUNT() - start;
+
+    for(i = 0; i < samples; i++){
+        next = (active == a) ? b : a;
+        start = _CP0_GET_COUNT();
+        profile_switch(next);
+        ticks = _CP0_GET_COUNT() - start - overhead;
+        if(ticks < min) min = ticks;
+        if(ticks > max) max = ticks;
+        total += ticks;
+    }
+
+    report->samples = samples;
+    report->min_ns = min * (1000000000UL / CORE_TIMER_FREQ);
+    report->max_ns = max * (1000000000UL / CORE_TIMER_FREQ);
+    report->avg_ns = (total / samples) * (1000000000UL / CORE_TIMER_FREQ);
+    return 1;
+}
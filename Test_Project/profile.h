@@ -0,0 +1,137 @@
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include "digital_io.h"
+#include "interrupts.h"
+
+/**
+ @Summary
+    Number of input PPS registers ([peripheral]R) held by a profile, four
+    bits each, packed eight per word
+ */
+#define PROFILE_INPUTS 24
+#define PROFILE_INPUT_WORDS ((PROFILE_INPUTS + 7) / 8)
+
+/**
+ @Summary
+    The struct is the register image of a pin configuration
+ @Description
+    The struct is allocated by the user and filled by <code>profile_capture</code>
+    from the live registers, after configuring the pins with the usual
+    <code>pin_*</code> calls. Switching between two images only writes the
+    bits that differ, through the SET/CLR aliases.
+ @Remarks
+    <ul>
+        <li><code>unsigned short ansel[IO_PORTS]</code> ... <code>cnen[IO_PORTS]</code> :
+            ANSELx, TRISx, LATx, ODCx, CNPUx, CNPDx and CNENx of every port</li>
+        <li><code>unsigned int rp[IO_PORTS][2]</code> : RPxnR output codes of
+            every port, bit n in nibble <code>n & 7</code> of word <code>n >> 3</code>
+            (0 for the pins that are not remappable)</li>
+        <li><code>unsigned int input_pps[PROFILE_INPUT_WORDS]</code> : input PPS
+            codes, in the order of the peripheral descriptors (INT1, INT2, ...)</li>
+    </ul>
+ */
+typedef struct{
+    unsigned short ansel[IO_PORTS];
+    unsigned short tris[IO_PORTS];
+    unsigned short lat[IO_PORTS];
+    unsigned short odc[IO_PORTS];
+    unsigned short cnpu[IO_PORTS];
+    unsigned short cnpd[IO_PORTS];
+    unsigned short cnen[IO_PORTS];
+    unsigned int rp[IO_PORTS][2];
+    unsigned int input_pps[PROFILE_INPUT_WORDS];
+} pin_profile;
+
+/**
+@Function
+    void profile_capture(pin_profile *p)
+
+@Summary
+    The function snapshots the current pin configuration into <code>p</code>,
+    which becomes the active profile.
+
+@Example
+    @code
+    pin_profile uart_mode, gpio_mode;
+    pin_assign_peripheral(&RB7, &U1TX);
+    pin_assign_peripheral(&RB13, &U1RX);
+    profile_capture(&uart_mode);
+    pin_assign_peripheral(&RB7, &OC1);
+    pin_select_working_mode(&RB13, ANALOGIC);
+    profile_capture(&gpio_mode);
+*/
+extern void profile_capture(pin_profile *p);
+
+/**
+@Function
+    void profile_switch(const pin_profile *to)
+
+@Summary
+    The function reconfigures the pins from the active profile to
+    <code>to</code>, writing only what differs.
+
+@Description
+    The images of the two profiles are XORed word by word: every register
+    costs one compare when unchanged, one SET and/or one CLR store otherwise,
+    and PPS registers are written only for the nibbles that differ. LATx is
+    written only for the pins whose level differs between the two images or
+    whose TRIS, ANSEL, ODC or RPxnR source changes: the other outputs keep
+    the level driven since the last switch.
+    The order keeps the pins from glitching:
+    <ol>
+        <li>notifications OFF and new pulls ON</li>
+        <li>pins leaving the output role released (TRIS SET), then ANSEL</li>
+        <li>input PPS, open drain and output levels (LAT) of the new role</li>
+        <li>RPxnR sources, then the new outputs driven (TRIS CLR)</li>
+        <li>old pulls OFF, then notifications ON, with PORTx read to reset
+            the mismatch condition</li>
+    </ol>
+
+@Precondition
+    A profile is active (<code>profile_capture</code> or a previous switch).
+    Registers changed by hand since then are not seen.
+    Peripherals and handlers using pins that change role should be stopped.
+
+@Parameters
+    @param to the profile to switch to
+*/
+extern void profile_switch(const pin_profile *to);
+
+/**
+@Function
+    const pin_profile *profile_active(void)
+
+@Summary
+    The function returns the active profile, NULL if none.
+*/
+extern const pin_profile *profile_active(void);
+
+/**
+@Function
+    unsigned char profile_measure_switch(const pin_profile *a, const pin_profile *b, unsigned int samples, latency_report *report)
+
+@Summary
+    The function measures the time of a switch, alternating between
+    <code>a</code> and <code>b</code>.
+
+@Description
+    Every <code>profile_switch</code> call is timed with the Core Timer, minus
+    the cost of the stamping itself. The resolution is two SYSCLK cycles. The
+    pins really switch: run it with the board in a state where both
+    configurations are harmless.
+
+@Returns
+<ul>
+    <li><code>1</code> if <code>report</code> has been filled</li>
+    <li><code>0</code> if no profile is active or <code>samples</code> is 0</li>
+</ul>
+
+@Example
+    @code
+    latency_report r;
+    profile_measure_switch(&uart_mode, &gpio_mode, 100, &r); //r.max_ns is a few us
+*/
+extern unsigned char profile_measure_switch(const pin_profile *a, const pin_profile *b, unsigned int samples, latency_report *report);
+
+#endif
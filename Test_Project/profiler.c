@@ -0,0 +1,130 @@
+#include <xc.h>
+#include <sys/attribs.h>
+#include "profiler.h"
+#include "uart.h"
+
+/* Core Timer interrupt: IFS0/IEC0 bit 0, priority in IPC0<4:2> */
+#define CORE_TIMER_FLAG 1
+#define CORE_TIMER_IPC_MASK 0x1F
+/* KSEG0 and KSEG1 addresses of the same location compare equal */
+#define PHYSICAL(a) ((unsigned int)(a) & 0x1FFFFFFF)
+/* Length of each loop of profiler_measure_overhead */
+#define WINDOW_TICKS (CORE_TIMER_FREQ / 10)
+
+static profiler_image image = { PROFILER_MAGIC, PROFILER_BASE, PROFILER_SHIFT, 0, PROFILER_BUCKETS, 0, 0, 0, { 0 } };
+static unsigned int period;
+static unsigned int dither_mask;
+static unsigned short lfsr = 0xACE1;
+
+static void halve(void){
+    unsigned int i;
+    for(i = 0; i < PROFILER_BUCKETS; i++) image.count[i] >>= 1;
+    image.outside >>= 1;
+    image.halvings++;
+}
+
+/*
+ * The prologue of an interrupt handler saves EPC on the stack and then
+ * re-enables interrupts: the CN vector at IPL7 could run before the body
+ * reads EPC, and leave there an address of this prologue. The handler keeps
+ * interrupts masked instead, so the EPC read is the one of the sampled code.
+ */
+void __ISR(_CORE_TIMER_VECTOR, PROFILER_INTERRUPT_IPL) __attribute__((keep_interrupts_masked)) profiler_vector(void){
+    unsigned int bucket = (PHYSICAL(_CP0_GET_EPC()) - PHYSICAL(PROFILER_BASE)) >> PROFILER_SHIFT;
+    unsigned int next;
+
+    if(bucket < PROFILER_BUCKETS){
+        if(++image.count[bucket] == 0xFFFF) halve();
+    }
+    else image.outside++;
+    image.samples++;
+
+    /* Galois LFSR, dithers the period around its nominal value */
+    lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xB400);
+    next = _CP0_GET_COMPARE() + period + (lfsr & dither_mask) - (dither_mask >> 1);
+    /* A late handler must not leave the compare behind the count */
+    if((int)(next - _CP0_GET_COUNT()) < (int)(period >> 2)) next = _CP0_GET_COUNT() + period;
+    _CP0_SET_COMPARE(next); /* Also clears the interrupt condition */
+    IFS0CLR = CORE_TIMER_FLAG;
+}
+
+unsigned char profiler_start(unsigned long rate_hz){
+    if(rate_hz == 0 || rate_hz > CORE_TIMER_FREQ / 1000) return 0;
+    IEC0CLR = CORE_TIMER_FLAG;
+    period = CORE_TIMER_FREQ / rate_hz;
+    /* Largest 2^n - 1 within 1/16 of the period: about +/-3% of dither */
+    for(dither_mask = 0; ((dither_mask << 1) | 1) <= period / 16; dither_mask = (dither_mask << 1) | 1);
+    image.rate_hz = rate_hz;
+    IPC0CLR = CORE_TIMER_IPC_MASK;
+    IPC0SET = (PROFILER_INTERRUPT_PRIORITY & 7) << 2;
+    _CP0_SET_COMPARE(_CP0_GET_COUNT() + period);
+    IFS0CLR = CORE_TIMER_FLAG;
+    IEC0SET = CORE_TIMER_FLAG;
+    return 1;
+}
+
+void profiler_stop(void){
+    IEC0CLR = CORE_TIMER_FLAG;
+}
+
+void profiler_clear(void){
+    unsigned int i, status;
+    status = __builtin_disable_interrupts();
+    for(i = 0; i < PROFILER_BUCKETS; i++) image.count[i] = 0;
+    image.samples = image.outside = 0;
+    image.halvings = 0;
+    if(status & 1) __builtin_enable_interrupts();
+}
+
+const profiler_image *profiler_data(void){
+    return &image;
+}
+
+void profiler_snapshot(profiler_image *copy){
+    unsigned int status;
+    status = __builtin_disable_interrupts();
+    *copy = image;
+    if(status & 1) __builtin_enable_interrupts();
+}
+
+void profiler_dump_uart(void){
+    static const char hex[16] = "0123456789ABCDEF";
+    profiler_image copy;
+    const unsigned char *bytes = (const unsigned char*)&copy;
+    unsigned char line[64];
+    unsigned int i, n = 0;
+
+    profiler_snapshot(&copy);
+    uart_write((const unsigned char*)"@PROF ", 6);
+    for(i = 0; i < sizeof(copy); i++){
+        line[n++] = hex[bytes[i] >> 4];
+        line[n++] = hex[bytes[i] & 15];
+        if(n == sizeof(line)){
+            uart_write(line, n);
+            n = 0;
+        }
+    }
+    line[n++] = '\r';
+    line[n++] = '\n';
+    uart_write(line, n);
+}
+
+/* Iterations of an empty loop within WINDOW_TICKS */
+static unsigned long spin(void){
+    unsigned long n = 0;
+    unsigned int start = _CP0_GET_COUNT();
+    while(_CP0_GET_COUNT() - start < WINDOW_TICKS) n++;
+    return n;
+}
+
+unsigned long profiler_measure_overhead(unsigned long rate_hz){
+    unsigned long idle, sampled;
+    profiler_stop();
+    idle = spin();
+    if(!profiler_start(rate_hz)) return 0;
+    sampled = spin();
+    profiler_stop();
+    profiler_clear();
+    if(sampled >= idle) return 0;
+    return (unsigned long)((unsigned long long)(idle - sampled) * 1000000UL / idle);
+}
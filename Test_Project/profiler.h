@@ -0,0 +1,194 @@
+#ifndef _PROFILER_H
+#define _PROFILER_H
+
+#include "interrupts.h"
+
+/**
+ @Summary
+    Priority of the sampling interrupt (Core Timer). It must be above the
+    code to observe: handlers at or above it are never sampled.
+ */
+#ifndef PROFILER_INTERRUPT_PRIORITY
+#define PROFILER_INTERRUPT_PRIORITY 6
+#endif
+#ifndef PROFILER_INTERRUPT_IPL
+#define PROFILER_INTERRUPT_IPL IPL6SOFT
+#endif
+
+/**
+ @Summary
+    Histogram geometry: PROFILER_BUCKETS buckets of 2^PROFILER_SHIFT bytes
+    from PROFILER_BASE. The defaults cover the 32 KB program flash of the
+    PIC32MX120F032B with 256-byte buckets in 256 bytes of RAM.
+ */
+#ifndef PROFILER_BASE
+#define PROFILER_BASE 0x9D000000UL
+#endif
+#ifndef PROFILER_SHIFT
+#define PROFILER_SHIFT 8
+#endif
+#ifndef PROFILER_BUCKETS
+#define PROFILER_BUCKETS 128
+#endif
+
+/**
+ @Summary
+    First word of a profiler image ("PCPF" in memory)
+ */
+#define PROFILER_MAGIC 0x46504350UL
+
+/**
+ @Summary
+    The struct is the histogram of the sampled program counters
+ @Description
+    The same layout is kept in RAM, copied by <code>profiler_snapshot</code>
+    and sent by <code>profiler_dump_uart</code>: little endian, no padding,
+    the header is 24 bytes long. host/profreport reads it and attributes
+    the buckets to the functions of the ELF file.
+ @Remarks
+    <ul>
+        <li><code>unsigned int magic</code> : PROFILER_MAGIC</li>
+        <li><code>unsigned int base</code> : address of the first bucket</li>
+        <li><code>unsigned char shift</code> : log2 of the bucket size in bytes</li>
+        <li><code>unsigned char halvings</code> : times every bucket and
+            <code>outside</code> have been halved because a bucket was saturating</li>
+        <li><code>unsigned short buckets</code> : number of buckets</li>
+        <li><code>unsigned int rate_hz</code> : sampling rate</li>
+        <li><code>unsigned int samples</code> : samples taken, never halved</li>
+        <li><code>unsigned int outside</code> : samples outside the buckets
+            (boot flash, RAM)</li>
+        <li><code>unsigned short count[PROFILER_BUCKETS]</code> : samples per bucket</li>
+    </ul>
+ */
+typedef struct{
+    unsigned int magic;
+    unsigned int base;
+    unsigned char shift;
+    unsigned char halvings;
+    unsigned short buckets;
+    unsigned int rate_hz;
+    unsigned int samples;
+    unsigned int outside;
+    unsigned short count[PROFILER_BUCKETS];
+} profiler_image;
+
+/**
+@Function
+    unsigned char profiler_start(unsigned long rate_hz)
+
+@Summary
+    The function starts sampling the interrupted program counter
+    <code>rate_hz</code> times per second.
+
+@Description
+    The Core Timer compare interrupt reads EPC, adds one to its bucket and
+    reloads the compare register. The period is dithered by a few percent
+    with a pseudo-random sequence, so loops running at a multiple of the
+    rate are not aliased. The Timer1..5 modules are left free.
+
+@Remarks
+    The sampling handler runs with interrupts masked from entry to return.
+    Otherwise a higher priority interrupt taken after its prologue would
+    overwrite EPC, and the sample would land in the profiler itself. So
+    while sampling, an interrupt at any priority, the IPL7 Change Notification
+    included, can be delayed by up to one profiler handler, a few dozen
+    cycles. Code running at or above PROFILER_INTERRUPT_PRIORITY is never
+    sampled.
+
+@Precondition
+    Call <code>interrupt_init</code> if not already done. The Core Timer
+    compare register is not used elsewhere.
+
+@Parameters
+    @param rate_hz samples per second, between 1 and CORE_TIMER_FREQ / 1000
+
+@Returns
+<ul>
+    <li><code>1</code> if the profiler is running</li>
+    <li><code>0</code> if the rate is out of range</li>
+</ul>
+
+@Example
+    @code
+    profiler_start(1000); //1 kHz, overhead measured by profiler_measure_overhead
+*/
+extern unsigned char profiler_start(unsigned long rate_hz);
+
+/**
+@Function
+    void profiler_stop(void)
+
+@Summary
+    The function stops sampling; the histogram is kept.
+*/
+extern void profiler_stop(void);
+
+/**
+@Function
+    void profiler_clear(void)
+
+@Summary
+    The function empties the histogram.
+*/
+extern void profiler_clear(void);
+
+/**
+@Function
+    const profiler_image *profiler_data(void)
+
+@Summary
+    The function returns the live histogram, <code>sizeof(profiler_image)</code>
+    bytes to read when dumping a memory region with a debugger or a loader.
+*/
+extern const profiler_image *profiler_data(void);
+
+/**
+@Function
+    void profiler_snapshot(profiler_image *copy)
+
+@Summary
+    The function copies the histogram, with sampling masked during the copy.
+*/
+extern void profiler_snapshot(profiler_image *copy);
+
+/**
+@Function
+    void profiler_dump_uart(void)
+
+@Summary
+    The function sends a snapshot of the histogram as one text line,
+    <code>@PROF</code> followed by the image in hexadecimal.
+
+@Description
+    The line can be picked out of a console log by host/profreport.
+
+@Precondition
+    <code>uart_init</code> called.
+*/
+extern void profiler_dump_uart(void);
+
+/**
+@Function
+    unsigned long profiler_measure_overhead(unsigned long rate_hz)
+
+@Summary
+    The function measures the CPU time taken by sampling at
+    <code>rate_hz</code>, in parts per million.
+
+@Description
+    A busy loop counts its iterations over a 100 ms window, with the profiler
+    stopped and then running: the missing iterations are the cost of the
+    whole interrupt, entry and exit included. Other interrupts add noise;
+    measure with the application idle. The histogram is cleared afterwards
+    and the profiler left stopped.
+
+@Returns
+    The overhead in ppm (1000 = 0.1 %), 0 if the rate is out of range.
+
+@Example
+    @code
+    profiler_measure_overhead(1000); //about 1000 * cycles per sample / SYS_FREQ * 1e6
+*/
+extern unsigned long profiler_measure_overhead(unsigned long rate_hz);
+
+#endif
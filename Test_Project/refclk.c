@@ -0,0 +1,105 @@
+#include <xc.h>
+#include "refclk.h"
+
+/* REFOCON */
+#define REFO_RODIV_SHIFT 16
+#define REFO_ON (1 << 15)
+#define REFO_OE (1 << 12)
+#define REFO_DIVSWEN (1 << 9)
+#define REFO_ACTIVE (1 << 8)
+/* REFOTRIM */
+#define REFO_ROTRIM_SHIFT 23
+
+#define FRC_FREQ 8000000UL
+#define LPRC_FREQ 31250UL
+#define SOSC_FREQ 32768UL
+
+/* Divider in 1/512 steps: Fout = Fin * 256 / (512 * RODIV + ROTRIM) */
+#define DIVIDER_MIN 512UL
+#define DIVIDER_MAX ((0x7FFFUL << 9) | 0x1FF)
+
+unsigned long refclk_source_freq(unsigned char source){
+    switch(source){
+        case REFCLK_SYSCLK: return SYS_FREQ;
+        case REFCLK_PBCLK: return PB_FREQ;
+        case REFCLK_POSC: return REFCLK_POSC_FREQ;
+        case REFCLK_FRC: return FRC_FREQ;
+        case REFCLK_LPRC: return LPRC_FREQ;
+        case REFCLK_SOSC: return SOSC_FREQ;
+        case REFCLK_REFCLKI: return REFCLK_REFCLKI_FREQ;
+        default: return 0;
+    }
+}
+
+static unsigned long long error_of(unsigned long long scaled, unsigned long long divider, unsigned long hz){
+    unsigned long long out = divider == 0 ? scaled / 256 : scaled / divider;
+    return out > (unsigned long long)hz * 1000 ? out - (unsigned long long)hz * 1000 : (unsigned long long)hz * 1000 - out;
+}
+
+unsigned char refclk_compute(unsigned char source, unsigned long hz, refclk_setting *s){
+    unsigned long fin = refclk_source_freq(source);
+    /* Output in mHz is scaled / divider; divider 0 stands for the bypass */
+    unsigned long long scaled = (unsigned long long)fin * 256 * 1000;
+    unsigned long long divider, best, candidate;
+    unsigned long long out;
+
+    if(fin == 0 || hz == 0 || hz > fin) return 0;
+    divider = ((unsigned long long)fin * 256 + hz / 2) / hz;
+    if(divider > DIVIDER_MAX + 1) return 0;
+    if(divider > DIVIDER_MAX) divider = DIVIDER_MAX;
+    if(divider < DIVIDER_MIN){
+        /* Between Fin / 2 and Fin only the two ends are available */
+        best = error_of(scaled, 0, hz) <= error_of(scaled, DIVIDER_MIN, hz) ? 0 : DIVIDER_MIN;
+    }
+    else{
+        best = divider;
+        for(candidate = divider - 1; candidate <= divider + 1; candidate++)
+            if(candidate >= DIVIDER_MIN && candidate <= DIVIDER_MAX && error_of(scaled, candidate, hz) < error_of(scaled, best, hz))
+                best = candidate;
+    }
+
+    s->rodiv = best >> 9;
+    s->rotrim = best & 0x1FF;
+    out = best == 0 ? scaled / 256 : scaled / best;
+    s->actual_hz = (out + 500) / 1000;
+    s->error_ppm = (long)(((long long)out - (long long)hz * 1000) * 1000 / (long long)hz);
+    return 1;
+}
+
+/* Waits for REFOCON bits to clear, 0 if still set after REFCLK_TIMEOUT_US */
+static unsigned char wait_clear(unsigned int bits){
+    unsigned int start = _CP0_GET_COUNT();
+    while(REFOCON & bits)
+        if(_CP0_GET_COUNT() - start > REFCLK_TIMEOUT_US * (CORE_TIMER_FREQ / 1000000UL)) return 0;
+    return 1;
+}
+
+unsigned char refclk_start(unsigned char source, unsigned long hz, const pin *output, refclk_setting *s){
+    refclk_setting setting;
+    if(!refclk_compute(source, hz, &setting)) return 0;
+    if(output != NULL && !pin_assign_peripheral(output, &REFCLKO)) return 0;
+
+    /* ROSEL and the divider may change only while the module is inactive */
+    REFOCONCLR = REFO_ON | REFO_OE;
+    if(!wait_clear(REFO_ACTIVE)) return 0;
+    REFOCON = (setting.rodiv << REFO_RODIV_SHIFT) | source;
+    REFOTRIM = setting.rotrim << REFO_ROTRIM_SHIFT;
+    /* The divider switch runs on the source clock, with the module ON */
+    REFOCONSET = REFO_ON;
+    REFOCONSET = REFO_DIVSWEN;
+    if(!wait_clear(REFO_DIVSWEN)){
+        REFOCONCLR = REFO_ON;
+        return 0;
+    }
+    if(output != NULL){
+        pin_set_direction(output, OUTPUT);
+        REFOCONSET = REFO_OE;
+    }
+    if(s != NULL) *s = setting;
+    return 1;
+}
+
+void refclk_stop(void){
+    REFOCONCLR = REFO_ON | REFO_OE;
+    (void)wait_clear(REFO_ACTIVE);
+}
@@ -0,0 +1,148 @@
+#ifndef _REFCLK_H
+#define _REFCLK_H
+
+#include "timers.h"
+
+/**
+ @Summary
+    Sources of the reference oscillator (REFOCON.ROSEL)
+ */
+#define REFCLK_SYSCLK  0
+#define REFCLK_PBCLK   1
+#define REFCLK_POSC    2
+#define REFCLK_FRC     3
+#define REFCLK_LPRC    4
+#define REFCLK_SOSC    5
+#define REFCLK_REFCLKI 8
+
+/**
+ @Summary
+    Frequency of the primary oscillator and of the clock fed on REFCLKI, in
+    Hz. 0 means not available: the source is refused. Set them from the
+    project settings when used.
+ */
+#ifndef REFCLK_POSC_FREQ
+#define REFCLK_POSC_FREQ 0UL
+#endif
+#ifndef REFCLK_REFCLKI_FREQ
+#define REFCLK_REFCLKI_FREQ 0UL
+#endif
+
+/**
+ @Summary
+    Longest wait, in us, for the module to stop or to switch its divider. A
+    source that gives no clock (crystal or REFCLKI signal missing) makes
+    <code>refclk_start</code> fail after it instead of hanging.
+ */
+#ifndef REFCLK_TIMEOUT_US
+#define REFCLK_TIMEOUT_US 1000UL
+#endif
+
+/**
+ @Summary
+    The divider chosen for a requested frequency
+ @Description
+    The output is Fin / (2 * (RODIV + ROTRIM / 512)), or Fin itself when
+    RODIV is 0. The 9-bit ROTRIM gives a fractional step of 1/512, so any
+    frequency from Fin / 2 down to about Fin / 65535 is reached with an
+    error below Fout^2 / (512 * Fin).
+ @Remarks
+    <ul>
+        <li><code>unsigned int rodiv</code> : integer part of the half divider (15 bits)</li>
+        <li><code>unsigned int rotrim</code> : fractional part, in 1/512 (9 bits)</li>
+        <li><code>unsigned long actual_hz</code> : output frequency, rounded to the Hz</li>
+        <li><code>long error_ppm</code> : signed error against the request, in parts per million</li>
+    </ul>
+ */
+typedef struct{
+    unsigned int rodiv;
+    unsigned int rotrim;
+    unsigned long actual_hz;
+    long error_ppm;
+} refclk_setting;
+
+/**
+@Function
+    unsigned long refclk_source_freq(unsigned char source)
+
+@Summary
+    The function returns the frequency of a source in Hz, 0 if unknown.
+*/
+extern unsigned long refclk_source_freq(unsigned char source);
+
+/**
+@Function
+    unsigned char refclk_compute(unsigned char source, unsigned long hz, refclk_setting *s)
+
+@Summary
+    The function finds the RODIV/ROTRIM pair closest to <code>hz</code>,
+    without touching the hardware.
+
+@Returns
+<ul>
+    <li><code>1</code> if <code>s</code> has been filled</li>
+    <li><code>0</code> if the source is unknown or <code>hz</code> is 0, above
+        the source or below its slowest division</li>
+</ul>
+
+@Example
+    @code
+    refclk_setting s;
+    refclk_compute(REFCLK_SYSCLK, 32768, &s); //s.rodiv = 610, s.rotrim = 180, s.error_ppm = 0
+*/
+extern unsigned char refclk_compute(unsigned char source, unsigned long hz, refclk_setting *s);
+
+/**
+@Function
+    unsigned char refclk_start(unsigned char source, unsigned long hz, const pin *output, refclk_setting *s)
+
+@Summary
+    The function starts the reference oscillator at the frequency closest to
+    <code>hz</code> and drives it on <code>output</code>.
+
+@Description
+    The oscillator is stopped and reconfigured, then turned ON and the
+    divider loaded with DIVSWEN, which the hardware clears once the switch
+    is done on the source clock; both waits are bounded by
+    REFCLK_TIMEOUT_US. REFCLKO is routed with
+    <code>pin_assign_peripheral</code>; once running, the clock costs no CPU.
+    The function interacts with REFOCON and REFOTRIM registers.
+
+@Precondition
+    For REFCLK_REFCLKI, the input clock pin must be assigned to the REFCLKI
+    peripheral.
+
+@Parameters
+    @param source one of the REFCLK_* sources
+    @param hz the requested frequency
+    @param output pin for REFCLKO (PPS group 3: RA2, RA4, RB2, RB6, RB13), NULL
+        to keep the clock internal
+    @param s filled with the setting in use, may be NULL
+
+@Returns
+<ul>
+    <li><code>1</code> if the clock is running</li>
+    <li><code>0</code> if the frequency cannot be reached or the pin cannot host
+        REFCLKO; the oscillator is left untouched</li>
+    <li><code>0</code> if the module does not stop or switch within
+        REFCLK_TIMEOUT_US (no clock from the source); the oscillator is
+        left OFF</li>
+</ul>
+
+@Example
+    @code
+    refclk_start(REFCLK_SYSCLK, 1000000, &RB2, NULL); //1 MHz on RB2
+*/
+extern unsigned char refclk_start(unsigned char source, unsigned long hz, const pin *output, refclk_setting *s);
+
+/**
+@Function
+    void refclk_stop(void)
+
+@Summary
+    The function stops the reference oscillator; the output pin goes back to
+    its LATx level.
+*/
+extern void refclk_stop(void);
+
+#endif
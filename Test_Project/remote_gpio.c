@@ -0,0 +1,235 @@
+#include <xc.h>
+#include "remote_gpio.h"
+
+/* Indexed by the REMOTE_<peripheral> identifiers */
+static const peripheral *const peripherals[REMOTE_PERIPHERALS] = {
+    &INT1, &INT2, &INT3, &INT4, &T2CK, &T3CK, &T4CK, &T5CK,
+    &IC1, &IC2, &IC3, &IC4, &IC5, &OC1, &OC2, &OC3, &OC4, &OC5,
+    &REFCLKI, &REFCLKO, &U1CTS, &U1RTS, &U1RX, &U1TX, &U2CTS, &U2RTS, &U2RX, &U2TX,
+    &SDI1, &SDO1, &SS1, &SDI2, &SDO2, &SS2, &OCFA, &OCFB, &C1OUT, &C2OUT, &C3OUT
+};
+
+#if REMOTE_MAX_GROUP > PIN_GROUP_SIZE
+#error "REMOTE_MAX_GROUP exceeds PIN_GROUP_SIZE"
+#endif
+
+static remote_receiver receiver;
+static unsigned char request[REMOTE_MAX_PAYLOAD];
+static unsigned char response[REMOTE_MAX_PAYLOAD];
+static unsigned char frame[REMOTE_MAX_FRAME];
+static unsigned int dropped;
+
+typedef struct{
+    unsigned char seq;
+    unsigned char port;
+    unsigned short changed;
+    unsigned short value;
+} remote_event;
+
+static unsigned short subscribed[IO_PORTS];
+static unsigned short last[IO_PORTS];
+static unsigned char cn_owned;
+static remote_event events[REMOTE_EVENT_QUEUE];
+static volatile unsigned char event_head;
+static unsigned char event_tail;
+static unsigned char event_seq;
+
+static unsigned short get16(const unsigned char *b){
+    return (b[0] << 8) | b[1];
+}
+
+static unsigned char *put16(unsigned char *b, unsigned short v){
+    b[0] = v >> 8;
+    b[1] = v & 0xFF;
+    return b + 2;
+}
+
+static void send(unsigned char *payload, unsigned int length){
+    uart_write(frame, remote_encode(payload, length, frame));
+}
+
+/*
+ * Runs in the Change Notification vector: every port is read once, which
+ * also ends the mismatch condition, and the subscribed changes are queued.
+ */
+static void remote_change_notice(void){
+    unsigned char p, next;
+    unsigned short value, changed;
+    for(p = 0; p < IO_PORTS; p++){
+        if(subscribed[p] == 0) continue;
+        value = *IO_REG(port_table[p], IO_PORT);
+        changed = (value ^ last[p]) & subscribed[p];
+        last[p] = value;
+        if(changed == 0) continue;
+        next = (event_head + 1) % REMOTE_EVENT_QUEUE;
+        if(next == event_tail){
+            event_seq++; /* Lost: the gap shows up on the host */
+            continue;
+        }
+        events[event_head].seq = event_seq++;
+        events[event_head].port = p;
+        events[event_head].changed = changed;
+        events[event_head].value = value;
+        event_head = next;
+    }
+}
+
+/* Returns 0 if another module owns the CN vector: nothing is changed then */
+static unsigned char subscribe(unsigned char p, unsigned short mask){
+    const interrupt_source *src = change_notice[p];
+    unsigned char q;
+    if(mask != 0 && !interrupt_attach(src, remote_change_notice)) return 0;
+    interrupt_enable(src, OFF);
+    *IO_REG(port_table[p], IO_CNEN + IO_CLR) = subscribed[p] & ~mask;
+    *IO_REG(port_table[p], IO_CNEN + IO_SET) = mask;
+    subscribed[p] = mask;
+    last[p] = *IO_REG(port_table[p], IO_PORT);
+    if(mask == 0){
+        /* Hand the vector over once the last subscription is gone */
+        for(q = 0; q < IO_PORTS && subscribed[q] == 0; q++);
+        if(q == IO_PORTS && cn_owned){
+            interrupt_attach(src, NULL);
+            cn_owned = 0;
+        }
+        return 1;
+    }
+    cn_owned = 1;
+    port_set_change_notice_behaviour(port_table[p], ON, ON);
+    interrupt_configure(src, CN_INTERRUPT_PRIORITY, 0);
+    interrupt_enable(src, ON);
+    return 1;
+}
+
+/* Pin of a REMOTE_PIN code, NULL if the device has no such pin */
+static const pin *find_pin(unsigned char code){
+    unsigned char i, port = code >> 4;
+    unsigned short mask = 1 << (code & 15);
+    if(port >= IO_PORTS) return NULL;
+    for(i = PIN_NONE + 1; i < PIN_COUNT; i++)
+        if(pin_table[i]->io == port_table[port] && pin_table[i]->mask == mask) return pin_table[i];
+    return NULL;
+}
+
+static inline void masked_write(const io_port *io, unsigned char reg, unsigned short mask, unsigned short value){
+    *IO_REG(io, reg + IO_CLR) = mask & ~value;
+    *IO_REG(io, reg + IO_SET) = mask & value;
+}
+
+/*
+ * Executes the operations of a request body and fills the response.
+ * Returns the response length.
+ */
+static unsigned int execute(const unsigned char *body, unsigned int length, unsigned char seq){
+    unsigned int i = 0;
+    unsigned char op, index = 0, status = REMOTE_OK, count, n, p, id;
+    unsigned short words[IO_PORTS], bits;
+    unsigned char *out = response + 4;
+    const unsigned char *results_end = response + 2 + REMOTE_MAX_BODY;
+    const pin *targets[REMOTE_MAX_GROUP], *target;
+
+    for(; i < length && status == REMOTE_OK; index++){
+        op = body[i++];
+        switch(op){
+            case REMOTE_OP_PORT_WRITE:
+            case REMOTE_OP_PORT_DIR:
+                if(i + 5 > length){ status = REMOTE_ERR_OP; break; }
+                if(body[i] >= IO_PORTS){ status = REMOTE_ERR_ARG; break; }
+                masked_write(port_table[body[i]], op == REMOTE_OP_PORT_WRITE ? IO_LAT : IO_TRIS, get16(body + i + 1), get16(body + i + 3));
+                i += 5;
+                break;
+            case REMOTE_OP_PULL:
+                if(i + 7 > length){ status = REMOTE_ERR_OP; break; }
+                if(body[i] >= IO_PORTS){ status = REMOTE_ERR_ARG; break; }
+                masked_write(port_table[body[i]], IO_CNPU, get16(body + i + 1), get16(body + i + 3));
+                masked_write(port_table[body[i]], IO_CNPD, get16(body + i + 1), get16(body + i + 5));
+                i += 7;
+                break;
+            case REMOTE_OP_PORT_READ:
+                if(i + 1 > length){ status = REMOTE_ERR_OP; break; }
+                if(body[i] >= IO_PORTS){ status = REMOTE_ERR_ARG; break; }
+                if(out + 2 > results_end){ status = REMOTE_ERR_SPACE; break; }
+                out = put16(out, *IO_REG(port_table[body[i]], IO_PORT));
+                i += 1;
+                break;
+            case REMOTE_OP_GROUP_READ:
+                if(i + 1 > length || i + 1 + body[i] > length){ status = REMOTE_ERR_OP; break; }
+                count = body[i];
+                if(count > REMOTE_MAX_GROUP){ status = REMOTE_ERR_ARG; break; }
+                for(n = 0; n < count; n++)
+                    if((targets[n] = find_pin(body[i + 1 + n])) == NULL) break;
+                if(n < count){ status = REMOTE_ERR_ARG; break; }
+                if(out + 2 > results_end){ status = REMOTE_ERR_SPACE; break; }
+                /* One snapshot of every port, then the bits are gathered */
+                for(p = 0; p < IO_PORTS; p++) words[p] = *IO_REG(port_table[p], IO_PORT);
+                bits = 0;
+                for(n = 0; n < count; n++)
+                    if(words[targets[n]->io->index] & targets[n]->mask) bits |= 1 << n;
+                out = put16(out, bits);
+                i += 1 + count;
+                break;
+            case REMOTE_OP_PPS_ASSIGN:
+                if(i + 2 > length){ status = REMOTE_ERR_OP; break; }
+                id = body[i + 1];
+                if((target = find_pin(body[i])) == NULL || id >= REMOTE_PERIPHERALS){ status = REMOTE_ERR_ARG; break; }
+                if(out + 1 > results_end){ status = REMOTE_ERR_SPACE; break; }
+                *out++ = pin_assign_peripheral(target, peripherals[id]);
+                i += 2;
+                break;
+            case REMOTE_OP_CN_SUBSCRIBE:
+                if(i + 3 > length){ status = REMOTE_ERR_OP; break; }
+                if(body[i] >= IO_PORTS){ status = REMOTE_ERR_ARG; break; }
+                if(!subscribe(body[i], get16(body + i + 1))){ status = REMOTE_ERR_BUSY; break; }
+                i += 3;
+                break;
+            default:
+                status = REMOTE_ERR_OP;
+        }
+    }
+
+    response[0] = REMOTE_RESPONSE;
+    response[1] = seq;
+    response[2] = status;
+    response[3] = status == REMOTE_OK ? 0 : index - 1;
+    return out - response;
+}
+
+unsigned char remote_gpio_init(const pin *tx, const pin *rx, unsigned long baud){
+    unsigned char p;
+    receiver.length = 0;
+    receiver.overflow = 0;
+    dropped = 0;
+    event_head = event_tail = 0;
+    event_seq = 0;
+    for(p = 0; p < IO_PORTS; p++) subscribed[p] = 0;
+    return uart_init(tx, rx, baud);
+}
+
+void remote_gpio_poll(void){
+    unsigned char chunk[16], body[7 + 2];
+    unsigned int n, i, length;
+
+    while((n = uart_read(chunk, sizeof(chunk))) != 0)
+        for(i = 0; i < n; i++){
+            if(!remote_receive(&receiver, chunk[i])) continue;
+            length = remote_decode(&receiver, request);
+            if(length < 2 || request[0] != REMOTE_REQUEST){
+                dropped++;
+                continue;
+            }
+            send(response, execute(request + 2, length - 2, request[1]));
+        }
+
+    while(event_tail != event_head){
+        body[0] = REMOTE_EVENT;
+        body[1] = events[event_tail].seq;
+        body[2] = events[event_tail].port;
+        put16(body + 3, events[event_tail].changed);
+        put16(body + 5, events[event_tail].value);
+        event_tail = (event_tail + 1) % REMOTE_EVENT_QUEUE;
+        send(body, 7);
+    }
+}
+
+unsigned int remote_gpio_dropped(void){
+    return dropped;
+}
@@ -0,0 +1,85 @@
+#ifndef _REMOTE_GPIO_H
+#define _REMOTE_GPIO_H
+
+#include "digital_io.h"
+#include "interrupts.h"
+#include "uart.h"
+#include "remote_protocol.h"
+
+/**
+ @Summary
+    Number of Change Notification events queued between two
+    <code>remote_gpio_poll</code> calls. Events beyond it are lost; the host
+    notices the gap in their sequence numbers.
+ */
+#ifndef REMOTE_EVENT_QUEUE
+#define REMOTE_EVENT_QUEUE 16
+#endif
+
+/**
+@Function
+    unsigned char remote_gpio_init(const pin *tx, const pin *rx, unsigned long baud)
+
+@Summary
+    The function starts the remote GPIO server on UART1.
+
+@Description
+    The server executes the batched requests of remote_protocol.h: a single
+    frame carries any number of port writes, direction and pull changes,
+    port and <code>pin_group</code> reads, PPS assignments and Change
+    Notification subscriptions, so a host drives many pins in one round trip.
+    Port operations are applied with the CLR/SET aliases, one store per
+    register and port, whatever the number of pins involved.
+
+@Precondition
+    <code>interrupt_init</code>, for the UART receiver and the events.
+
+@Parameters
+    @param tx pin of the U1TX output
+    @param rx pin of the U1RX input
+    @param baud the bit rate
+
+@Returns
+<ul>
+    <li><code>1</code> if the server has been started</li>
+    <li><code>0</code> if <code>uart_init</code> failed</li>
+</ul>
+
+@Remarks
+    Subscriptions take the Change Notification vector: do not use them with
+    the encoder module or other handlers attached to CN_A/CN_B.
+
+@Example
+    @code
+    interrupt_init();
+    remote_gpio_init(&RB7, &RB13, 115200);
+    while(1) remote_gpio_poll();
+*/
+extern unsigned char remote_gpio_init(const pin *tx, const pin *rx, unsigned long baud);
+
+/**
+@Function
+    void remote_gpio_poll(void)
+
+@Summary
+    The function executes the requests received so far, answering each of
+    them, and sends the queued Change Notification events.
+
+@Description
+    Requests are answered in the order they arrived, so the host can keep
+    several of them in flight. The function does not block on reception; it
+    only waits for room in the transmit FIFO while answering.
+*/
+extern void remote_gpio_poll(void);
+
+/**
+@Function
+    unsigned int remote_gpio_dropped(void)
+
+@Summary
+    The function returns the number of frames dropped because malformed,
+    with a wrong CRC or not a request.
+*/
+extern unsigned int remote_gpio_dropped(void);
+
+#endif
@@ -0,0 +1,75 @@
+#include "remote_protocol.h"
+
+static const unsigned short crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+unsigned short remote_crc16(const unsigned char *data, unsigned int length){
+    unsigned short crc = 0xFFFF;
+    while(length--){
+        crc = (crc << 4) ^ crc_nibble[(crc >> 12) ^ (*data >> 4)];
+        crc = (crc << 4) ^ crc_nibble[(crc >> 12) ^ (*data & 15)];
+        data++;
+    }
+    return crc;
+}
+
+unsigned int remote_encode(unsigned char *payload, unsigned int length, unsigned char *frame){
+    unsigned short crc = remote_crc16(payload, length);
+    unsigned int i, code_at = 0, out = 1;
+    unsigned char code = 1;
+    payload[length++] = crc >> 8;
+    payload[length++] = crc & 0xFF;
+    for(i = 0; i < length; i++){
+        if(payload[i] == 0){
+            frame[code_at] = code;
+            code_at = out++;
+            code = 1;
+            continue;
+        }
+        frame[out++] = payload[i];
+        if(++code == 0xFF){
+            frame[code_at] = code;
+            code_at = out++;
+            code = 1;
+        }
+    }
+    frame[code_at] = code;
+    frame[out++] = 0;
+    return out;
+}
+
+unsigned char remote_receive(remote_receiver *r, unsigned char byte){
+    if(byte == 0){
+        if(r->overflow || r->length == 0){
+            r->overflow = 0;
+            r->length = 0;
+            return 0;
+        }
+        return 1;
+    }
+    if(r->length == sizeof(r->frame)) r->overflow = 1;
+    else r->frame[r->length++] = byte;
+    return 0;
+}
+
+unsigned int remote_decode(remote_receiver *r, unsigned char *payload){
+    unsigned int i = 0, out = 0, length = r->length;
+    unsigned char code, j;
+    r->length = 0;
+    while(i < length){
+        code = r->frame[i++];
+        for(j = 1; j < code; j++){
+            if(i == length || out == REMOTE_MAX_PAYLOAD) return 0;
+            payload[out++] = r->frame[i++];
+        }
+        if(code != 0xFF && i < length){
+            if(out == REMOTE_MAX_PAYLOAD) return 0;
+            payload[out++] = 0;
+        }
+    }
+    if(out < 4) return 0;
+    if(remote_crc16(payload, out - 2) != ((payload[out - 2] << 8) | payload[out - 1])) return 0;
+    return out - 2;
+}
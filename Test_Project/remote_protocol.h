@@ -0,0 +1,179 @@
+#ifndef _REMOTE_PROTOCOL_H
+#define _REMOTE_PROTOCOL_H
+
+/*
+ * Remote GPIO protocol, shared by the device (remote_gpio.c) and the host
+ * client (host/remote_client.c). This header and remote_protocol.c do not
+ * depend on the MCU and build unchanged with XC32 and with a host compiler.
+ *
+ * Every frame is COBS encoded and terminated by a 0x00 byte. Decoded, it is
+ *
+ *     kind (1) | seq (1) | body (up to REMOTE_MAX_BODY) | crc (2, MSB first)
+ *
+ * with the CRC-16/CCITT-FALSE of kind, seq and body. Frames with a wrong
+ * CRC are dropped without answer: the host detects the loss by timeout.
+ *
+ * A REQUEST body is a list of operations, executed in order. The RESPONSE
+ * carries the seq of its request and a body made of a status byte, the
+ * index of the failing operation (0 when the status is REMOTE_OK) and the
+ * results of the operations, concatenated in the same order. Operations
+ * before a failing one have been executed and their results are there. The host may send several
+ * requests before reading the responses (pipelining): the device answers
+ * them in order.
+ *
+ * Multi-byte fields are MSB first. Ports are numbered from 0 (RA) to
+ * IO_PORTS - 1 of the device build (RC = 2 on the 44-pin packages); an
+ * operation on a port the device lacks fails with REMOTE_ERR_ARG. Pins are
+ * REMOTE_PIN(port, bit), so a host does not depend on the pin_table of the
+ * package the device was built for.
+ */
+
+/* Port numbers and pin codes of the operations */
+#define REMOTE_PORT_A 0
+#define REMOTE_PORT_B 1
+#define REMOTE_PORT_C 2
+#define REMOTE_PIN(port, bit) ((unsigned char)(((port) << 4) | (bit)))
+
+/* Most pins of a REMOTE_OP_GROUP_READ, the PIN_GROUP_SIZE of the device */
+#define REMOTE_MAX_GROUP 16
+
+#define REMOTE_REQUEST  0x01
+#define REMOTE_RESPONSE 0x02
+#define REMOTE_EVENT    0x03
+
+/* Operation                 arguments                     result */
+#define REMOTE_OP_PORT_WRITE   0x01 /* port, mask16, value16   -                        */
+#define REMOTE_OP_PORT_DIR     0x02 /* port, mask16, inputs16  -                        */
+#define REMOTE_OP_PORT_READ    0x03 /* port                    PORTx (2)                */
+#define REMOTE_OP_GROUP_READ   0x04 /* count, pin[count]       bit n = pin n (2)        */
+#define REMOTE_OP_PPS_ASSIGN   0x05 /* pin, peripheral         1 legal, 0 illegal (1)   */
+#define REMOTE_OP_CN_SUBSCRIBE 0x06 /* port, mask16            -                        */
+#define REMOTE_OP_PULL         0x07 /* port, mask16, up16, down16  -                    */
+
+#define REMOTE_OK        0x00
+#define REMOTE_ERR_OP    0x01 /* unknown or truncated operation */
+#define REMOTE_ERR_ARG   0x02 /* port, pin or peripheral out of range */
+#define REMOTE_ERR_SPACE 0x03 /* results would not fit in the response */
+#define REMOTE_ERR_BUSY  0x04 /* CN vector owned by another module of the device */
+
+/*
+ * EVENT body: port, changed16, value16. Sent when a subscribed pin changes;
+ * seq counts the events, so the host can detect lost ones.
+ */
+
+#define REMOTE_MAX_BODY 240
+#define REMOTE_MAX_PAYLOAD (REMOTE_MAX_BODY + 4)
+/* COBS overhead (1 byte every 254) and the delimiter */
+#define REMOTE_MAX_FRAME (REMOTE_MAX_PAYLOAD + 3)
+
+/* Peripheral identifiers of REMOTE_OP_PPS_ASSIGN */
+#define REMOTE_INT1     0
+#define REMOTE_INT2     1
+#define REMOTE_INT3     2
+#define REMOTE_INT4     3
+#define REMOTE_T2CK     4
+#define REMOTE_T3CK     5
+#define REMOTE_T4CK     6
+#define REMOTE_T5CK     7
+#define REMOTE_IC1      8
+#define REMOTE_IC2      9
+#define REMOTE_IC3      10
+#define REMOTE_IC4      11
+#define REMOTE_IC5      12
+#define REMOTE_OC1      13
+#define REMOTE_OC2      14
+#define REMOTE_OC3      15
+#define REMOTE_OC4      16
+#define REMOTE_OC5      17
+#define REMOTE_REFCLKI  18
+#define REMOTE_REFCLKO  19
+#define REMOTE_U1CTS    20
+#define REMOTE_U1RTS    21
+#define REMOTE_U1RX     22
+#define REMOTE_U1TX     23
+#define REMOTE_U2CTS    24
+#define REMOTE_U2RTS    25
+#define REMOTE_U2RX     26
+#define REMOTE_U2TX     27
+#define REMOTE_SDI1     28
+#define REMOTE_SDO1     29
+#define REMOTE_SS1      30
+#define REMOTE_SDI2     31
+#define REMOTE_SDO2     32
+#define REMOTE_SS2      33
+#define REMOTE_OCFA     34
+#define REMOTE_OCFB     35
+#define REMOTE_C1OUT    36
+#define REMOTE_C2OUT    37
+#define REMOTE_C3OUT    38
+#define REMOTE_PERIPHERALS 39
+
+/**
+ @Summary
+    Incremental decoder of the incoming byte stream
+ @Remarks
+    <ul>
+        <li><code>unsigned char frame[]</code> : the encoded bytes of the frame being received</li>
+        <li><code>unsigned short length</code> : number of bytes in <code>frame</code></li>
+        <li><code>unsigned char overflow</code> : set when the frame is longer than
+            REMOTE_MAX_FRAME, the frame is dropped at its delimiter</li>
+    </ul>
+ */
+typedef struct{
+    unsigned char frame[REMOTE_MAX_FRAME];
+    unsigned short length;
+    unsigned char overflow;
+} remote_receiver;
+
+/**
+@Function
+    unsigned short remote_crc16(const unsigned char *data, unsigned int length)
+
+@Summary
+    The function returns the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of
+    the buffer. It uses a 16-entry nibble table (32 bytes).
+*/
+extern unsigned short remote_crc16(const unsigned char *data, unsigned int length);
+
+/**
+@Function
+    unsigned int remote_encode(unsigned char *payload, unsigned int length, unsigned char *frame)
+
+@Summary
+    The function appends the CRC to <code>payload</code> (which must have 2
+    spare bytes), COBS encodes it into <code>frame</code> (REMOTE_MAX_FRAME
+    bytes) and terminates it.
+
+@Returns
+    The number of bytes of <code>frame</code> to send.
+*/
+extern unsigned int remote_encode(unsigned char *payload, unsigned int length, unsigned char *frame);
+
+/**
+@Function
+    unsigned char remote_receive(remote_receiver *r, unsigned char byte)
+
+@Summary
+    The function feeds one received byte to the decoder.
+
+@Returns
+    1 when <code>byte</code> is the delimiter of a complete frame, which can then
+    be extracted with <code>remote_decode</code>; 0 otherwise.
+*/
+extern unsigned char remote_receive(remote_receiver *r, unsigned char byte);
+
+/**
+@Function
+    unsigned int remote_decode(remote_receiver *r, unsigned char *payload)
+
+@Summary
+    The function COBS decodes the received frame into <code>payload</code>
+    (REMOTE_MAX_PAYLOAD bytes) and checks its CRC. The receiver is reset for
+    the next frame.
+
+@Returns
+    The length of the payload without the CRC, 0 if the frame is malformed.
+*/
+extern unsigned int remote_decode(remote_receiver *r, unsigned char *payload);
+
+#endif
@@ -0,0 +1,284 @@
+#include <xc.h>
+#include "rules.h"
+
+/*
+ * A term matches when every port word, masked, equals its level. AND terms
+ * use the active levels and fire on a match; OR terms use the rest levels
+ * and fire on a mismatch. The outcome selects which of the SET/CLR words
+ * receive the output bit.
+ */
+typedef struct{
+    unsigned short mask[IO_PORTS];
+    unsigned short level[IO_PORTS];
+    unsigned char negate;
+    unsigned char port;
+    unsigned short set_on_hit;
+    unsigned short clr_on_hit;
+    unsigned short set_on_miss;
+    unsigned short clr_on_miss;
+} rule_term;
+
+static rule_term terms[RULES_MAX_TERMS];
+static unsigned char terms_count = 0;
+
+static unsigned short inputs[IO_PORTS];
+static unsigned short outputs[IO_PORTS];
+static unsigned char input_ports = 0;
+static volatile unsigned int *port_reg[IO_PORTS];
+static volatile unsigned int *set_reg[IO_PORTS];
+static volatile unsigned int *clr_reg[IO_PORTS];
+
+#if RULES_MEASURE
+static unsigned int measure_overhead;
+static volatile unsigned int evaluations;
+static volatile unsigned int finished;
+static unsigned int stat_min = 0xFFFFFFFF, stat_max, stat_total, stat_count;
+#endif
+
+static unsigned char output_free(const pin *output){
+    unsigned char p = output->io->index;
+    return !((outputs[p] | inputs[p]) & output->mask);
+}
+
+static unsigned char input_free(const pin *input){
+    return !(outputs[input->io->index] & input->mask);
+}
+
+/* Term n of the rule being declared, not visible to the handler until commit */
+static rule_term *new_term(const pin *output, unsigned char n){
+    rule_term *t;
+    unsigned char p;
+    if(terms_count + n >= RULES_MAX_TERMS) return NULL;
+    t = &terms[terms_count + n];
+    for(p = 0; p < IO_PORTS; p++) t->mask[p] = t->level[p] = 0;
+    t->negate = 0;
+    t->port = output->io->index;
+    t->set_on_hit = t->clr_on_hit = t->set_on_miss = t->clr_on_miss = 0;
+    return t;
+}
+
+static void add_input(rule_term *t, const pin *input, unsigned char level){
+    unsigned char p = input->io->index;
+    t->mask[p] |= input->mask;
+    if(level == HIGH) t->level[p] |= input->mask;
+    inputs[p] |= input->mask;
+}
+
+/* Publishes the terms: the handler only looks at terms[0..terms_count) */
+static void commit(const pin *output, unsigned char count){
+    outputs[output->io->index] |= output->mask;
+    terms_count += count;
+}
+
+static unsigned char rule_single(const pin *output, const pin *input, unsigned char level){
+    rule_term *t;
+    if(!output_free(output) || !input_free(input) || input == output) return 0;
+    if((t = new_term(output, 0)) == NULL) return 0;
+    add_input(t, input, level);
+    t->set_on_hit = t->clr_on_miss = output->mask;
+    commit(output, 1);
+    return 1;
+}
+
+unsigned char rule_follow(const pin *output, const pin *input){
+    return rule_single(output, input, HIGH);
+}
+
+unsigned char rule_invert(const pin *output, const pin *input){
+    return rule_single(output, input, LOW);
+}
+
+static unsigned char rule_group(const pin *output, const pin_group *group, unsigned short inverted, unsigned char any){
+    rule_term *t;
+    unsigned char i;
+    if(!output_free(output) || (*group)[0] == PIN_NONE) return 0;
+    for(i = 0; i < PIN_GROUP_SIZE && (*group)[i] != PIN_NONE; i++)
+        if((*group)[i] >= PIN_COUNT || !input_free(pin_table[(*group)[i]]) || pin_table[(*group)[i]] == output) return 0;
+    if((t = new_term(output, 0)) == NULL) return 0;
+    /* AND matches the active levels, OR the rest levels: active HIGH rests LOW */
+    for(i = 0; i < PIN_GROUP_SIZE && (*group)[i] != PIN_NONE; i++)
+        add_input(t, pin_table[(*group)[i]], ((inverted >> i) & 1) == any ? HIGH : LOW);
+    t->negate = any;
+    t->set_on_hit = t->clr_on_miss = output->mask;
+    commit(output, 1);
+    return 1;
+}
+
+unsigned char rule_and(const pin *output, const pin_group *inputs, unsigned short inverted){
+    return rule_group(output, inputs, inverted, 0);
+}
+
+unsigned char rule_or(const pin *output, const pin_group *inputs, unsigned short inverted){
+    return rule_group(output, inputs, inverted, 1);
+}
+
+unsigned char rule_latch(const pin *output, const pin *set, const pin *reset){
+    rule_term *s, *r;
+    if(!output_free(output) || !input_free(set) || !input_free(reset) || set == output || reset == output) return 0;
+    if((s = new_term(output, 0)) == NULL || (r = new_term(output, 1)) == NULL) return 0;
+    add_input(s, set, HIGH);
+    s->set_on_hit = output->mask;
+    add_input(r, reset, HIGH);
+    r->clr_on_hit = output->mask;
+    commit(output, 2);
+    return 1;
+}
+
+unsigned char rules_start(void){
+    unsigned char p, bit;
+    const pin *q;
+    /* Before any CNEN bit is set: the owner's handler would not read our ports */
+    if(!interrupt_attach(&CN_B, rules_change_notice_handler)) return 0;
+    input_ports = 0;
+    for(p = 0; p < IO_PORTS; p++){
+        port_reg[p] = IO_REG(port_table[p], IO_PORT);
+        set_reg[p] = IO_REG(port_table[p], IO_PORT + IO_SET);
+        clr_reg[p] = IO_REG(port_table[p], IO_PORT + IO_CLR);
+        if(inputs[p]) input_ports |= 1 << p;
+    }
+    for(bit = PIN_NONE + 1; bit < PIN_COUNT; bit++){
+        q = pin_table[bit];
+        if(!(inputs[q->io->index] & q->mask)) continue;
+        pin_set_direction(q, INPUT);
+        pin_select_working_mode(q, DIGITAL);
+        pin_assign_interrupt_on_change(q, ON);
+    }
+
+#if RULES_MEASURE
+    {
+        unsigned int start = _CP0_GET_COUNT();
+        measure_overhead = _CP0_GET_COUNT() - start;
+    }
+#endif
+    /* The first evaluation loads LATx, then the outputs are driven */
+    rules_change_notice_handler();
+#if RULES_MEASURE
+    stat_min = 0xFFFFFFFF;
+    stat_max = stat_total = stat_count = 0;
+#endif
+    for(bit = PIN_NONE + 1; bit < PIN_COUNT; bit++){
+        q = pin_table[bit];
+        if(!(outputs[q->io->index] & q->mask)) continue;
+        pin_select_working_mode(q, DIGITAL);
+        pin_set_direction(q, OUTPUT);
+    }
+
+    for(p = 0; p < IO_PORTS; p++)
+        if(input_ports & (1 << p)){
+            port_set_change_notice_behaviour(port_table[p], ON, ON);
+            interrupt_configure(change_notice[p], CN_INTERRUPT_PRIORITY, 0);
+        }
+    for(p = 0; p < IO_PORTS; p++)
+        if(input_ports & (1 << p)) interrupt_enable(change_notice[p], ON);
+    return 1;
+}
+
+void rules_change_notice_handler(void){
+    unsigned int words[IO_PORTS];
+    unsigned short set[IO_PORTS], clr[IO_PORTS];
+    const rule_term *t, *end = terms + terms_count;
+    unsigned char p, hit;
+#if RULES_MEASURE
+    unsigned int start = _CP0_GET_COUNT(), ticks;
+#endif
+
+    /* Reading PORTx also clears the mismatch condition of the port */
+    for(p = 0; p < IO_PORTS; p++){
+        words[p] = (input_ports & (1 << p)) ? *port_reg[p] : 0;
+        set[p] = clr[p] = 0;
+    }
+
+    for(t = terms; t < end; t++){
+        for(p = 0; p < IO_PORTS; p++)
+            if((words[p] & t->mask[p]) != t->level[p]) break;
+        hit = (p == IO_PORTS) ^ t->negate;
+        set[t->port] |= hit ? t->set_on_hit : t->set_on_miss;
+        clr[t->port] |= hit ? t->clr_on_hit : t->clr_on_miss;
+    }
+
+    /* CLR wins: a latch with both inputs HIGH stays LOW without a glitch */
+    for(p = 0; p < IO_PORTS; p++){
+        set[p] &= ~clr[p];
+        if(set[p]) *set_reg[p] = set[p];
+        if(clr[p]) *clr_reg[p] = clr[p];
+    }
+
+#if RULES_MEASURE
+    finished = _CP0_GET_COUNT();
+    ticks = finished - start - measure_overhead;
+    if(ticks < stat_min) stat_min = ticks;
+    if(ticks > stat_max) stat_max = ticks;
+    stat_total += ticks;
+    stat_count++;
+    evaluations++;
+#endif
+}
+
+#if RULES_MEASURE
+static void mask_change_notice(unsigned char masked){
+    unsigned char p;
+    for(p = 0; p < IO_PORTS; p++)
+        if(input_ports & (1 << p)){
+            if(masked) *(change_notice[p]->iec_clr) = change_notice[p]->mask;
+            else *(change_notice[p]->iec_set) = change_notice[p]->mask; /* Keep a pending edge */
+        }
+}
+
+static void fill_report(latency_report *report, unsigned int min, unsigned int max, unsigned int total, unsigned int count){
+    report->samples = count;
+    if(count == 0) count = 1;
+    report->min_ns = min == 0xFFFFFFFF ? 0 : min * (1000000000UL / CORE_TIMER_FREQ);
+    report->max_ns = max * (1000000000UL / CORE_TIMER_FREQ);
+    report->avg_ns = (total / count) * (1000000000UL / CORE_TIMER_FREQ);
+}
+#endif
+
+unsigned char rules_evaluation_time(latency_report *report){
+#if RULES_MEASURE
+    unsigned int min, max, total, count;
+    mask_change_notice(1);
+    min = stat_min;
+    max = stat_max;
+    total = stat_total;
+    count = stat_count;
+    stat_min = 0xFFFFFFFF;
+    stat_max = stat_total = stat_count = 0;
+    mask_change_notice(0);
+    fill_report(report, min, max, total, count);
+    return count != 0;
+#else
+    (void)report;
+    return 0;
+#endif
+}
+
+unsigned char rules_measure_latency(const pin *stimulus, unsigned int samples, latency_report *report){
+#if RULES_MEASURE
+    unsigned int i, start, seen, ticks, total = 0;
+    unsigned int min = 0xFFFFFFFF, max = 0;
+    unsigned char ok = 1;
+
+    for(i = 0; i < samples && ok; i++){
+        seen = evaluations;
+        start = _CP0_GET_COUNT();
+        *IO_REG(stimulus->io, IO_PORT + IO_INV) = stimulus->mask;
+        while(evaluations == seen)
+            if(_CP0_GET_COUNT() - start > CORE_TIMER_FREQ / 1000){
+                ok = 0;
+                break;
+            }
+        if(!ok) break;
+        ticks = finished - start - measure_overhead;
+        if(ticks < min) min = ticks;
+        if(ticks > max) max = ticks;
+        total += ticks;
+    }
+    fill_report(report, min, max, total, i);
+    return ok;
+#else
+    (void)stimulus;
+    (void)samples;
+    (void)report;
+    return 0;
+#endif
+}
@@ -0,0 +1,218 @@
+#ifndef _RULES_H
+#define _RULES_H
+
+#include "digital_io.h"
+#include "interrupts.h"
+
+/**
+ @Summary
+    Maximum number of compiled terms. FOLLOW, INVERT, AND and OR rules take
+    one term, LATCH rules take two.
+ */
+#ifndef RULES_MAX_TERMS
+#define RULES_MAX_TERMS 32
+#endif
+
+/**
+ @Summary
+    1 to stamp every evaluation with the Core Timer, needed by
+    <code>rules_evaluation_time</code> and <code>rules_measure_latency</code>.
+    It costs two CP0 reads and a few compares per interrupt, so production
+    builds leave it at 0 and the measurement build passes -DRULES_MEASURE=1.
+ */
+#ifndef RULES_MEASURE
+#define RULES_MEASURE 0
+#endif
+
+/**
+@Function
+    unsigned char rule_follow(const pin *output, const pin *input)
+
+@Summary
+    The function declares <code>output = input</code>.
+
+@Description
+    Rules are declared over pin descriptors and compiled on the spot into
+    per-port mask/level pairs: the Change Notification handler tests a whole
+    port with one AND and one compare, whatever the number of inputs.
+
+@Precondition
+    None. Call <code>rules_start</code> once every rule is declared.
+
+@Parameters
+    @param output pin driven by the rule
+    @param input pin sampled by the rule
+
+@Returns
+<ul>
+    <li><code>1</code> if the rule has been compiled</li>
+    <li><code>0</code> if the table is full, the output is already driven by
+        another rule or the output is also used as an input</li>
+</ul>
+
+@Example
+    @code
+    rule_follow(&RA4, &RB1); //RA4 follows RB1
+*/
+extern unsigned char rule_follow(const pin *output, const pin *input);
+
+/**
+@Function
+    unsigned char rule_invert(const pin *output, const pin *input)
+
+@Summary
+    The function declares <code>output = !input</code>. Same returns as
+    <code>rule_follow</code>.
+*/
+extern unsigned char rule_invert(const pin *output, const pin *input);
+
+/**
+@Function
+    unsigned char rule_and(const pin *output, const pin_group *inputs, unsigned short inverted)
+
+@Summary
+    The function declares <code>output</code> HIGH when every input is active.
+
+@Parameters
+    @param output pin driven by the rule
+    @param inputs the inputs, on any port
+    @param inverted bit i set when <code>(*inputs)[i]</code> is active LOW
+
+@Returns
+<ul>
+    <li><code>1</code> if the rule has been compiled</li>
+    <li><code>0</code> as for <code>rule_follow</code>, or if the group is empty</li>
+</ul>
+
+@Example
+    @code
+    pin_group enable = { PIN_RB4, PIN_RB5 };
+    rule_and(&RB2, &enable, 0x0002); //RB2 = RB4 && !RB5
+*/
+extern unsigned char rule_and(const pin *output, const pin_group *inputs, unsigned short inverted);
+
+/**
+@Function
+    unsigned char rule_or(const pin *output, const pin_group *inputs, unsigned short inverted)
+
+@Summary
+    The function declares <code>output</code> HIGH when any input is active.
+    Same parameters and returns as <code>rule_and</code>; NAND and NOR are an
+    OR and an AND of the inverted inputs.
+*/
+extern unsigned char rule_or(const pin *output, const pin_group *inputs, unsigned short inverted);
+
+/**
+@Function
+    unsigned char rule_latch(const pin *output, const pin *set, const pin *reset)
+
+@Summary
+    The function declares a set/reset latch: <code>output</code> goes HIGH
+    while <code>set</code> is HIGH, LOW while <code>reset</code> is HIGH and
+    keeps its level otherwise.
+
+@Remarks
+    Reset wins when both inputs are HIGH. The output starts LOW unless
+    <code>set</code> is HIGH when <code>rules_start</code> runs. Same returns
+    as <code>rule_follow</code>.
+*/
+extern unsigned char rule_latch(const pin *output, const pin *set, const pin *reset);
+
+/**
+@Function
+    unsigned char rules_start(void)
+
+@Summary
+    The function configures the pins, drives every output once and attaches
+    the engine to the Change Notification vector.
+
+@Description
+    Inputs are set as INPUT and DIGITAL with Interrupt On Change active, and
+    the Change Notification is turned ON for their ports. The rules are
+    evaluated before the outputs are switched to OUTPUT, so they never show
+    a stale LATx level.
+
+@Returns
+<ul>
+    <li><code>1</code> if the rules are running</li>
+    <li><code>0</code> if another handler owns the Change Notification vector;
+        nothing has been configured</li>
+</ul>
+
+@Remarks
+    Call <code>interrupt_init</code> afterwards if not already done. If other
+    modules need the Change Notification vector, attach a function calling
+    <code>rules_change_notice_handler</code> instead.
+*/
+extern unsigned char rules_start(void);
+
+/**
+@Function
+    void rules_change_notice_handler(void)
+
+@Summary
+    Change Notification handler evaluating every rule.
+
+@Description
+    One PORTx read per input port, then for every term an AND and a compare
+    per port; the outcome ORs the output bit into the SET or CLR word of the
+    output port. At most one SET and one CLR store per output port follow,
+    whatever the number of rules.
+*/
+extern void rules_change_notice_handler(void);
+
+/**
+@Function
+    unsigned char rules_evaluation_time(latency_report *report)
+
+@Summary
+    The function reports the time spent by the handler since the previous
+    call, from its first PORTx read to its last store, and restarts the count.
+
+@Returns
+<ul>
+    <li><code>1</code> if <code>report</code> has been filled</li>
+    <li><code>0</code> if no evaluation ran or RULES_MEASURE is 0</li>
+</ul>
+
+@Example
+    @code
+    latency_report r;
+    rules_evaluation_time(&r); //r.max_ns is the worst case of the rule set
+*/
+extern unsigned char rules_evaluation_time(latency_report *report);
+
+/**
+@Function
+    unsigned char rules_measure_latency(const pin *stimulus, unsigned int samples, latency_report *report)
+
+@Summary
+    The function measures the time between an edge on a rule input and the
+    end of the resulting evaluation.
+
+@Description
+    <code>stimulus</code> must be wired to an input of a rule. The function
+    toggles it and waits for the handler, which stamps the Core Timer after
+    its last store. The difference against the stamp taken at the stimulus
+    write, minus the cost of the stamping itself, covers the interrupt entry
+    and the whole evaluation. The resolution is two SYSCLK cycles.
+
+@Precondition
+    <code>rules_start</code> and <code>interrupt_init</code> called,
+    <code>stimulus</code> set as OUTPUT.
+
+@Returns
+<ul>
+    <li><code>1</code> if every edge has been evaluated</li>
+    <li><code>0</code> if the handler did not run within 1 ms (loopback
+        missing) or RULES_MEASURE is 0</li>
+</ul>
+
+@Example
+    @code
+    latency_report r;
+    rules_measure_latency(&RA3, 1000, &r); //RA3 looped back on a rule input
+*/
+extern unsigned char rules_measure_latency(const pin *stimulus, unsigned int samples, latency_report *report);
+
+#endif
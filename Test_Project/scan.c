@@ -0,0 +1,304 @@
+#include <xc.h>
+#include "scan.h"
+
+#define SCAN_KEYPAD  0
+#define SCAN_DISPLAY 1
+
+static unsigned char mode;
+static const timer *scan_timer;
+static unsigned char brightness = SCAN_BRIGHTNESS_MAX;
+static unsigned char rows_count;
+static unsigned char row;
+
+/*
+ * Every step is: first store on every used port turns all rows (and display
+ * columns) OFF, second store selects the row. Display rows active HIGH use
+ * PORT CLR then SET, active LOW use SET then CLR. Keypad rows keep LAT at 0
+ * and are released by TRIS SET, then the selected one driven by TRIS CLR:
+ * two rows are never driven at opposite levels, whatever keys are pressed.
+ */
+static unsigned char used_ports[IO_PORTS];
+static unsigned char used_count;
+static volatile unsigned int *first_reg[IO_PORTS];
+static volatile unsigned int *second_reg[IO_PORTS];
+static unsigned short controlled[IO_PORTS];
+static unsigned short row_mask[IO_PORTS];
+static unsigned short row_bits[SCAN_MAX_ROWS][IO_PORTS];
+static volatile unsigned short second[SCAN_MAX_ROWS][IO_PORTS];
+static unsigned char rows_active_low;
+
+static volatile unsigned int *column_port;
+static unsigned char column_index;
+static unsigned char columns_count;
+static unsigned char columns_active_low;
+static unsigned short column_mask;
+static unsigned short gather[4][16];
+static unsigned short scatter[4][16];
+
+static unsigned short scratch[SCAN_MAX_ROWS];
+static volatile unsigned short keys[SCAN_MAX_ROWS];
+static volatile unsigned char ghost;
+static volatile unsigned int frames;
+
+static unsigned short period_ticks, on_ticks, off_ticks;
+static unsigned char blanking, dark, in_blank;
+
+static unsigned char port_index(const pin *p){
+    return p->io->index;
+}
+
+static unsigned char compile_rows(const pin_group *rows){
+    unsigned char i, p;
+    unsigned short all[IO_PORTS] = { 0 };
+    const pin *r;
+    for(i = 0; i < PIN_GROUP_SIZE && (*rows)[i] != PIN_NONE; i++){
+        if(i == SCAN_MAX_ROWS) return 0;
+        r = pin_table[(*rows)[i]];
+        for(p = 0; p < IO_PORTS; p++) row_bits[i][p] = 0;
+        p = port_index(r);
+        row_bits[i][p] = r->mask;
+        all[p] |= r->mask;
+    }
+    if(i == 0) return 0;
+    rows_count = i;
+    for(p = 0; p < IO_PORTS; p++) controlled[p] = row_mask[p] = all[p];
+    return 1;
+}
+
+static unsigned char compile_columns(const pin_group *columns){
+    unsigned char i, n, bit;
+    const pin *c;
+    for(i = 0; i < 4; i++)
+        for(n = 0; n < 16; n++) gather[i][n] = scatter[i][n] = 0;
+    column_mask = 0;
+    for(i = 0; i < PIN_GROUP_SIZE && (*columns)[i] != PIN_NONE; i++){
+        c = pin_table[(*columns)[i]];
+        if(i == 0) column_index = port_index(c);
+        else if(port_index(c) != column_index) return 0;
+        column_mask |= c->mask;
+        for(bit = 0; (1u << bit) != c->mask; bit++);
+        /* physical nibble value -> logical bits, logical nibble value -> physical bits */
+        for(n = 0; n < 16; n++){
+            if(n & (1 << (bit & 3))) gather[bit >> 2][n] |= 1 << i;
+            if(n & (1 << (i & 3))) scatter[i >> 2][n] |= c->mask;
+        }
+    }
+    if(i == 0) return 0;
+    columns_count = i;
+    column_port = IO_REG(port_table[column_index], IO_PORT);
+    return 1;
+}
+
+static void compile_ports(unsigned char first_store, unsigned char second_store){
+    unsigned char p;
+    used_count = 0;
+    for(p = 0; p < IO_PORTS; p++){
+        if(controlled[p] == 0) continue;
+        used_ports[used_count++] = p;
+        first_reg[p] = IO_REG(port_table[p], first_store);
+        second_reg[p] = IO_REG(port_table[p], second_store);
+    }
+}
+
+/*
+ * Second store of a row, from the wanted level of the controlled bits: after
+ * the first store every controlled bit is at the OFF level of the rows.
+ */
+static unsigned short compile_word(unsigned char p, unsigned short target){
+    return rows_active_low ? (controlled[p] & ~target) : target;
+}
+
+/* Wanted level of the row bits of a port when row r is selected */
+static unsigned short row_target(unsigned char r, unsigned char p){
+    return rows_active_low ? (row_mask[p] & ~row_bits[r][p]) : row_bits[r][p];
+}
+
+static inline void all_off(void){
+    unsigned char i;
+    for(i = 0; i < used_count; i++)
+        *first_reg[used_ports[i]] = controlled[used_ports[i]];
+}
+
+static inline void select_row(unsigned char r){
+    unsigned char i, p;
+    for(i = 0; i < used_count; i++){
+        p = used_ports[i];
+        *first_reg[p] = controlled[p];
+    }
+    for(i = 0; i < used_count; i++){
+        p = used_ports[i];
+        *second_reg[p] = second[r][p];
+    }
+}
+
+static inline unsigned short gather_columns(unsigned int word){
+    return gather[0][word & 15] | gather[1][(word >> 4) & 15] | gather[2][(word >> 8) & 15] | gather[3][(word >> 12) & 15];
+}
+
+static void end_of_frame(void){
+    unsigned char i, j;
+    unsigned short shared;
+    for(i = 0; i < rows_count; i++)
+        for(j = i + 1; j < rows_count; j++){
+            shared = scratch[i] & scratch[j];
+            if(shared & (shared - 1)){
+                ghost = 1;
+                frames++;
+                return;
+            }
+        }
+    for(i = 0; i < rows_count; i++) keys[i] = scratch[i];
+    ghost = 0;
+    frames++;
+}
+
+static void scan_keypad_tick(void){
+    /* Columns are pulled up: a pressed key reads LOW */
+    scratch[row] = ~gather_columns(*column_port) & ((1u << columns_count) - 1);
+    if(++row == rows_count){
+        row = 0;
+        end_of_frame();
+    }
+    select_row(row);
+}
+
+static void scan_display_tick(void){
+    if(dark){
+        all_off();
+        return;
+    }
+    if(blanking && !in_blank){
+        all_off();
+        *(scan_timer->pr) = off_ticks - 1;
+        in_blank = 1;
+        return;
+    }
+    if(++row == rows_count){
+        row = 0;
+        frames++;
+    }
+    select_row(row);
+    if(blanking){
+        *(scan_timer->pr) = on_ticks - 1;
+        in_blank = 0;
+    }
+}
+
+/* Splits the row slot of the display for the stored brightness */
+static void apply_brightness(void){
+    unsigned short on = (unsigned long)period_ticks * brightness / SCAN_BRIGHTNESS_MAX;
+    dark = (brightness == 0 || on < SCAN_MIN_PHASE);
+    blanking = !dark && (period_ticks - on >= SCAN_MIN_PHASE);
+    on_ticks = on;
+    off_ticks = period_ticks - on;
+    if(!blanking){
+        *(scan_timer->pr) = period_ticks - 1;
+        in_blank = 0;
+    }
+}
+
+static unsigned char scan_setup_timer(const timer *t, unsigned long row_period_us, interrupt_handler tick){
+    timer_stop(t);
+    interrupt_enable(t->irq, OFF);
+    if(!timer_set_period_us(t, row_period_us)) return 0;
+    scan_timer = t;
+    period_ticks = *(t->pr) + 1;
+    interrupt_attach(t->irq, tick);
+    interrupt_configure(t->irq, TIMER_INTERRUPT_PRIORITY, 0);
+    interrupt_enable(t->irq, ON);
+    return 1;
+}
+
+unsigned char scan_keypad_init(const pin_group *rows, const pin_group *columns, const timer *t, unsigned long row_period_us){
+    unsigned char i, p;
+    mode = SCAN_KEYPAD;
+    rows_active_low = 1;
+    columns_active_low = 1;
+    if(!compile_rows(rows) || !compile_columns(columns)) return 0;
+    compile_ports(IO_TRIS + IO_SET, IO_TRIS + IO_CLR);
+    for(i = 0; i < rows_count; i++){
+        for(p = 0; p < IO_PORTS; p++) second[i][p] = row_bits[i][p];
+        scratch[i] = keys[i] = 0;
+    }
+    /* Released rows float, the column pull-ups hold the lines HIGH */
+    for(i = 0; i < rows_count; i++){
+        pin_set_direction(pin_table[(*rows)[i]], INPUT);
+        pin_set_output_low(pin_table[(*rows)[i]]);
+    }
+    for(i = 0; i < columns_count; i++){
+        pin_set_direction(pin_table[(*columns)[i]], INPUT);
+        pin_select_working_mode(pin_table[(*columns)[i]], DIGITAL);
+        pin_assign_pull_up(pin_table[(*columns)[i]], ON);
+    }
+    row = 0;
+    ghost = 0;
+    frames = 0;
+    select_row(row);
+    return scan_setup_timer(t, row_period_us, scan_keypad_tick);
+}
+
+unsigned char scan_display_init(const pin_group *rows, const pin_group *columns, unsigned char rows_low, unsigned char columns_low, const timer *t, unsigned long row_period_us){
+    unsigned char i;
+    mode = SCAN_DISPLAY;
+    rows_active_low = rows_low;
+    columns_active_low = columns_low;
+    if(!compile_rows(rows) || !compile_columns(columns)) return 0;
+    controlled[column_index] |= column_mask;
+    compile_ports(IO_PORT + (rows_active_low ? IO_SET : IO_CLR), IO_PORT + (rows_active_low ? IO_CLR : IO_SET));
+    for(i = 0; i < rows_count; i++) scan_display_write(i, 0);
+    all_off();
+    for(i = 0; i < rows_count; i++) pin_set_direction(pin_table[(*rows)[i]], OUTPUT);
+    for(i = 0; i < columns_count; i++) pin_set_direction(pin_table[(*columns)[i]], OUTPUT);
+    row = rows_count - 1; /* The first tick selects row 0 */
+    frames = 0;
+    in_blank = 0;
+    if(!scan_setup_timer(t, row_period_us, scan_display_tick)) return 0;
+    apply_brightness();
+    return 1;
+}
+
+void scan_start(void){
+    timer_start(scan_timer);
+}
+
+void scan_stop(void){
+    timer_stop(scan_timer);
+    all_off();
+}
+
+void scan_display_write(unsigned char r, unsigned int value){
+    unsigned char p;
+    unsigned short pattern, target;
+    if(r >= rows_count) return;
+    pattern = scatter[0][value & 15] | scatter[1][(value >> 4) & 15] | scatter[2][(value >> 8) & 15] | scatter[3][(value >> 12) & 15];
+    if(columns_active_low) pattern = column_mask & ~pattern;
+    for(p = 0; p < IO_PORTS; p++){
+        target = row_target(r, p);
+        if(p == column_index) target |= pattern;
+        second[r][p] = compile_word(p, target);
+    }
+}
+
+void scan_display_set_brightness(unsigned char level){
+    const interrupt_source *irq;
+    brightness = level;
+    /* Before scan_display_init the level is only stored */
+    if(scan_timer == NULL || mode != SCAN_DISPLAY) return;
+    irq = scan_timer->irq;
+    *(irq->iec_clr) = irq->mask;
+    apply_brightness();
+    *(irq->iec_set) = irq->mask;
+}
+
+unsigned int scan_keypad_read(unsigned char r){
+    if(mode != SCAN_KEYPAD || r >= rows_count) return 0;
+    return keys[r];
+}
+
+unsigned char scan_keypad_ghost(void){
+    return ghost;
+}
+
+unsigned int scan_frames(void){
+    return frames;
+}
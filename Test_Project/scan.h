@@ -0,0 +1,195 @@
+#ifndef _SCAN_H
+#define _SCAN_H
+
+#include "digital_io.h"
+#include "timers.h"
+
+/**
+ @Summary
+    Maximum number of rows handled by the scan engine
+ */
+#ifndef SCAN_MAX_ROWS
+#define SCAN_MAX_ROWS 16
+#endif
+
+/**
+ @Summary
+    Shortest ON or blanking phase in timer ticks. Shorter phases are rounded
+    to full ON or full OFF, so that PRx is never written below TMRx.
+ */
+#define SCAN_MIN_PHASE 16
+
+/**
+ @Summary
+    Full brightness value for <code>scan_display_set_brightness</code>
+ */
+#define SCAN_BRIGHTNESS_MAX 255
+
+/**
+@Function
+    unsigned char scan_keypad_init(const pin_group *rows, const pin_group *columns, const timer *t, unsigned long row_period_us)
+
+@Summary
+    The function prepares the scan engine for a keypad matrix.
+
+@Description
+    Rows are active LOW: their LAT stays at 0 and a row is selected by
+    driving it (TRISxCLR) after releasing the others (TRISxSET), so two
+    keys pressed in the same column never short a LOW row to a HIGH one.
+    Columns are read with internal pull-ups. Every row is compiled into the
+    words to store in the TRISxSET/TRISxCLR aliases, and the column pins
+    into nibble gather tables, so that one timer tick costs one PORTx read,
+    one SET and one CLR store per port involved.
+    The columns of a row are sampled one full period after the row has been
+    selected, leaving the lines time to settle.
+
+@Precondition
+    None. Call <code>scan_start</code> and <code>interrupt_init</code> afterwards.
+
+@Parameters
+    @param rows <code>pin_group</code> of row pins, on RA and/or RB
+    @param columns <code>pin_group</code> of column pins, all on the same port
+    @param t the timer pacing the scan; its vector is attached to the engine
+    @param row_period_us time each row stays selected
+
+@Returns
+<ul>
+    <li><code>1</code> if the engine has been configured</li>
+    <li><code>0</code> if the groups are empty or too large, the columns span
+        several ports or the period does not fit the timer</li>
+</ul>
+
+@Remarks
+    The engine is a singleton: a keypad and a display cannot be scanned at the
+    same time.
+
+@Example
+    @code
+    const pin_group rows = { PIN_RB0, PIN_RB1, PIN_RB2, PIN_RB3 };
+    const pin_group cols = { PIN_RB7, PIN_RB8, PIN_RB9 };
+    scan_keypad_init(&rows, &cols, &T2, 1000);
+    scan_start();
+*/
+extern unsigned char scan_keypad_init(const pin_group *rows, const pin_group *columns, const timer *t, unsigned long row_period_us);
+
+/**
+@Function
+    unsigned char scan_display_init(const pin_group *rows, const pin_group *columns, unsigned char rows_active_low, unsigned char columns_active_low, const timer *t, unsigned long row_period_us)
+
+@Summary
+    The function prepares the scan engine for a multiplexed LED array.
+
+@Description
+    At every row step the engine turns every row and column OFF with one store
+    per port, then selects the row and its column pattern with a second one, so
+    no segment is ever lit with the pattern of another row. The column pattern
+    is mapped from logical to physical bits with nibble scatter tables when
+    written, not in the interrupt.
+
+@Parameters
+    @param rows <code>pin_group</code> of row (digit) pins
+    @param columns <code>pin_group</code> of column (segment) pins, all on the same port
+    @param rows_active_low 1 if a row is selected when driven LOW
+    @param columns_active_low 1 if a segment is lit when its column is driven LOW
+    @param t the timer pacing the scan
+    @param row_period_us time slot of each row
+
+@Returns
+<ul>
+    <li><code>1</code> if the engine has been configured</li>
+    <li><code>0</code> if the groups are not valid or the period does not fit the timer</li>
+</ul>
+
+@Example
+    @code
+    scan_display_init(&digits, &segments, 1, 0, &T2, 2000);
+    scan_display_write(0, 0x3F);
+    scan_start();
+*/
+extern unsigned char scan_display_init(const pin_group *rows, const pin_group *columns, unsigned char rows_active_low, unsigned char columns_active_low, const timer *t, unsigned long row_period_us);
+
+/**
+@Function
+    void scan_start(void)
+
+@Summary
+    The function starts the timer pacing the scan.
+*/
+extern void scan_start(void);
+
+/**
+@Function
+    void scan_stop(void)
+
+@Summary
+    The function stops the scan and turns every row OFF.
+*/
+extern void scan_stop(void);
+
+/**
+@Function
+    void scan_display_write(unsigned char row, unsigned int columns)
+
+@Summary
+    The function sets the column pattern shown on the given row.
+
+@Description
+    Bit n of <code>columns</code> is the n-th pin of the columns group. The
+    physical word is compiled here and published with a single store, so the
+    interrupt never sees a half-written pattern.
+*/
+extern void scan_display_write(unsigned char row, unsigned int columns);
+
+/**
+@Function
+    void scan_display_set_brightness(unsigned char level)
+
+@Summary
+    The function sets the duty cycle of every row, 0 (dark) to
+    <code>SCAN_BRIGHTNESS_MAX</code>.
+
+@Description
+    Below full brightness each row slot is split in an ON phase and a blanking
+    phase by reloading PRx from the interrupt, so the dimming costs one more
+    interrupt per row and no CPU otherwise.
+
+@Remarks
+    The level is kept across <code>scan_display_init</code> calls: set before
+    the display is initialized, it is applied by the initialization.
+    Defaults to <code>SCAN_BRIGHTNESS_MAX</code>.
+*/
+extern void scan_display_set_brightness(unsigned char level);
+
+/**
+@Function
+    unsigned int scan_keypad_read(unsigned char row)
+
+@Summary
+    The function returns the keys pressed on the given row in the last valid
+    frame. Bit n is the n-th pin of the columns group.
+
+@Remarks
+    Frames with ghost keys are not published: the previous valid frame is kept.
+*/
+extern unsigned int scan_keypad_read(unsigned char row);
+
+/**
+@Function
+    unsigned char scan_keypad_ghost(void)
+
+@Summary
+    The function returns 1 if the last frame was discarded because of ghost
+    keys (two rows sharing two or more pressed columns), 0 otherwise.
+*/
+extern unsigned char scan_keypad_ghost(void);
+
+/**
+@Function
+    unsigned int scan_frames(void)
+
+@Summary
+    The function returns the number of complete frames scanned so far.
+*/
+extern unsigned int scan_frames(void);
+
+#endif
@@ -0,0 +1,59 @@
+#include <xc.h>
+#include "timers.h"
+
+const timer T1 = { &T1CON, &T1CONCLR, &T1CONSET, &TMR1, &PR1, &TIMER1, 0 } ;
+const timer T2 = { &T2CON, &T2CONCLR, &T2CONSET, &TMR2, &PR2, &TIMER2, 1 } ;
+const timer T3 = { &T3CON, &T3CONCLR, &T3CONSET, &TMR3, &PR3, &TIMER3, 1 } ;
+const timer T4 = { &T4CON, &T4CONCLR, &T4CONSET, &TMR4, &PR4, &TIMER4, 1 } ;
+const timer T5 = { &T5CON, &T5CONCLR, &T5CONSET, &TMR5, &PR5, &TIMER5, 1 } ;
+
+/* TCKPS field: Type A <5:4>, Type B <6:4> */
+#define TCKPS_SHIFT 4
+#define TCKPS_MASK_A (3 << TCKPS_SHIFT)
+#define TCKPS_MASK_B (7 << TCKPS_SHIFT)
+#define TIMER_ON (1 << 15)
+
+static const unsigned short prescalers_a[4] = { 1, 8, 64, 256 };
+static const unsigned short prescalers_b[8] = { 1, 2, 4, 8, 16, 32, 64, 256 };
+
+unsigned char timer_set_period(const timer *t, unsigned long ticks){
+    const unsigned short *prescalers = t->type_b ? prescalers_b : prescalers_a;
+    unsigned char i, count = t->type_b ? 8 : 4;
+    if(ticks == 0) return 0;
+    for(i = 0; i < count; i++)
+        if((ticks + prescalers[i] - 1) / prescalers[i] <= 0x10000) break;
+    if(i == count) return 0;
+    *(t->con_clr) = TIMER_ON | (t->type_b ? TCKPS_MASK_B : TCKPS_MASK_A);
+    *(t->con_set) = i << TCKPS_SHIFT;
+    *(t->tmr) = 0;
+    *(t->pr) = (ticks + prescalers[i] - 1) / prescalers[i] - 1;
+    return 1;
+}
+
+unsigned char timer_set_period_us(const timer *t, unsigned long us){
+    return timer_set_period(t, (unsigned long)((unsigned long long)PB_FREQ * us / 1000000UL));
+}
+
+unsigned char timer_set_prescaler(const timer *t, unsigned int ratio){
+    const unsigned short *prescalers = t->type_b ? prescalers_b : prescalers_a;
+    unsigned char i, count = t->type_b ? 8 : 4;
+    for(i = 0; i < count; i++)
+        if(prescalers[i] == ratio) break;
+    if(i == count) return 0;
+    *(t->con_clr) = t->type_b ? TCKPS_MASK_B : TCKPS_MASK_A;
+    *(t->con_set) = i << TCKPS_SHIFT;
+    return 1;
+}
+
+unsigned int timer_prescaler(const timer *t){
+    if(t->type_b) return prescalers_b[(*(t->con) & TCKPS_MASK_B) >> TCKPS_SHIFT];
+    return prescalers_a[(*(t->con) & TCKPS_MASK_A) >> TCKPS_SHIFT];
+}
+
+inline void timer_start(const timer *t){
+    *(t->con_set) = TIMER_ON;
+}
+
+inline void timer_stop(const timer *t){
+    *(t->con_clr) = TIMER_ON;
+}
@@ -0,0 +1,136 @@
+#ifndef _TIMERS_H
+#define _TIMERS_H
+
+#include "interrupts.h"
+
+/**
+ @Summary
+    Peripheral Bus clock divisor, as set by FPBDIV in <code>main.c</code>
+ */
+#ifndef PB_DIV
+#define PB_DIV 8
+#endif
+
+/**
+ @Summary
+    Peripheral Bus clock frequency in Hz, the clock of every timer
+ */
+#define PB_FREQ (SYS_FREQ / PB_DIV)
+
+/**
+ @Summary
+    The struct represents one of the 16-bit timers of the MCU
+ @Description
+    As for io_port, the struct holds the pointers to the registers of the
+    timer, together with the interrupt source raised on period match.
+    Timer1 is a Type A timer (prescalers 1, 8, 64, 256); Timer2 to Timer5 are
+    Type B timers (prescalers 1, 2, 4, 8, 16, 32, 64, 256) and can be paired
+    in 32-bit mode (Timer2/3, Timer4/5).
+ @Remarks
+    <ul>
+        <li><code>volatile unsigned int *con</code> : pointer to the TxCON register</li>
+        <li><code>volatile unsigned int *con_clr</code> : pointer to the TxCONCLR register</li>
+        <li><code>volatile unsigned int *con_set</code> : pointer to the TxCONSET register</li>
+        <li><code>volatile unsigned int *tmr</code> : pointer to the TMRx counter</li>
+        <li><code>volatile unsigned int *pr</code> : pointer to the PRx period register</li>
+        <li><code>const interrupt_source *irq</code> : period match interrupt source</li>
+        <li><code>const unsigned char type_b</code> : 1 for Timer2 to Timer5, 0 for Timer1</li>
+    </ul>
+ */
+typedef struct{
+    volatile unsigned int *con;
+    volatile unsigned int *con_clr;
+    volatile unsigned int *con_set;
+    volatile unsigned int *tmr;
+    volatile unsigned int *pr;
+    const interrupt_source *irq;
+    const unsigned char type_b;
+} timer;
+
+extern const timer T1;
+extern const timer T2;
+extern const timer T3;
+extern const timer T4;
+extern const timer T5;
+
+/**
+@Function
+    unsigned char timer_set_period(const timer *t, unsigned long ticks)
+
+@Summary
+    The function sets the period of the timer, in PBCLK cycles.
+
+@Description
+    The smallest prescaler for which the period fits the 16-bit PRx register is
+    selected, so the resolution is the best available. The timer is stopped
+    and cleared; use <code>timer_start</code> afterwards.
+
+@Parameters
+    @param t A <code>const *timer</code> from the available ones
+    @param ticks the period in PBCLK cycles
+
+@Returns
+<ul>
+    <li><code>1</code> if the period has been set</li>
+    <li><code>0</code> if the period exceeds 65536 * 256 cycles; nothing is done</li>
+</ul>
+
+@Example
+    @code
+    timer_set_period(&T2, PB_FREQ / 1000); //1 ms period
+*/
+extern unsigned char timer_set_period(const timer *t, unsigned long ticks);
+
+/**
+@Function
+    unsigned char timer_set_period_us(const timer *t, unsigned long us)
+
+@Summary
+    Same as <code>timer_set_period</code>, with the period in microseconds.
+*/
+extern unsigned char timer_set_period_us(const timer *t, unsigned long us);
+
+/**
+@Function
+    unsigned char timer_set_prescaler(const timer *t, unsigned int ratio)
+
+@Summary
+    The function selects the prescaler ratio of the timer, leaving the rest
+    of TxCON untouched.
+
+@Returns
+<ul>
+    <li><code>1</code> if the ratio has been selected</li>
+    <li><code>0</code> if the timer has no such prescaler</li>
+</ul>
+*/
+extern unsigned char timer_set_prescaler(const timer *t, unsigned int ratio);
+
+/**
+@Function
+    unsigned int timer_prescaler(const timer *t)
+
+@Summary
+    The function returns the prescaler ratio currently selected on the timer.
+*/
+extern unsigned int timer_prescaler(const timer *t);
+
+/**
+@Function
+    inline void timer_start(const timer *t)
+
+@Summary
+    The function turns the timer ON. Interacts with TxCONSET.
+*/
+extern inline void timer_start(const timer *t);
+
+/**
+@Function
+    inline void timer_stop(const timer *t)
+
+@Summary
+    The function turns the timer OFF. Interacts with TxCONCLR.
+*/
+extern inline void timer_stop(const timer *t);
+
+#endif
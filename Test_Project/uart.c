@@ -0,0 +1,89 @@
+#include <xc.h>
+#include "uart.h"
+
+/* U1MODE */
+#define UART_ON (1 << 15)
+#define UART_BRGH (1 << 3)
+/* U1STA */
+#define UART_URXEN (1 << 12)
+#define UART_UTXEN (1 << 10)
+#define UART_UTXBF (1 << 9)
+#define UART_OERR (1 << 1)
+#define UART_URXDA (1 << 0)
+
+static volatile unsigned char rx_buffer[UART_RX_BUFFER];
+static volatile unsigned char rx_head;
+static unsigned char rx_tail;
+static volatile unsigned int overruns;
+
+#if UART_RX_BUFFER == 256
+#define RX_WRAP(i) ((unsigned char)(i))
+#else
+#define RX_WRAP(i) ((unsigned char)((i) & (UART_RX_BUFFER - 1)))
+#endif
+
+static void uart_receive(void){
+    unsigned char head = rx_head;
+    while(U1STA & UART_URXDA){
+        unsigned char c = U1RXREG;
+        if(RX_WRAP(head + 1) == rx_tail) overruns++;
+        else{
+            rx_buffer[head] = c;
+            head = RX_WRAP(head + 1);
+        }
+    }
+    /* OERR stops the receiver until cleared, the FIFO content is kept */
+    if(U1STA & UART_OERR){
+        U1STACLR = UART_OERR;
+        overruns++;
+    }
+    rx_head = head;
+}
+
+unsigned char uart_init(const pin *tx, const pin *rx, unsigned long baud){
+    unsigned long brg, actual;
+    if(baud == 0) return 0;
+    brg = (PB_FREQ + 2 * baud) / (4 * baud);
+    if(brg == 0 || brg > 0x10000) return 0;
+    actual = PB_FREQ / (4 * brg);
+    if((actual > baud ? actual - baud : baud - actual) * 100 > baud * 3) return 0;
+    if(!pin_assign_peripheral(tx, &U1TX) || !pin_assign_peripheral(rx, &U1RX)) return 0;
+
+    interrupt_enable(&UART1_RX, OFF);
+    U1MODE = 0;
+    pin_set_output_high(tx);
+    pin_set_direction(tx, OUTPUT);
+    pin_select_working_mode(rx, DIGITAL);
+    pin_set_direction(rx, INPUT);
+    U1BRG = brg - 1;
+    U1STA = UART_URXEN | UART_UTXEN; /* URXISEL = 0: flag on every character */
+    rx_head = rx_tail = 0;
+    overruns = 0;
+    interrupt_attach(&UART1_RX, uart_receive);
+    interrupt_configure(&UART1_RX, UART_INTERRUPT_PRIORITY, 0);
+    U1MODE = UART_ON | UART_BRGH;
+    interrupt_enable(&UART1_RX, ON);
+    return 1;
+}
+
+unsigned int uart_read(unsigned char *data, unsigned int length){
+    unsigned int n = 0;
+    unsigned char tail = rx_tail, head = rx_head;
+    while(n < length && tail != head){
+        data[n++] = rx_buffer[tail];
+        tail = RX_WRAP(tail + 1);
+    }
+    rx_tail = tail;
+    return n;
+}
+
+void uart_write(const unsigned char *data, unsigned int length){
+    while(length--){
+        while(U1STA & UART_UTXBF);
+        U1TXREG = *data++;
+    }
+}
+
+unsigned int uart_overruns(void){
+    return overruns;
+}
@@ -0,0 +1,85 @@
+#ifndef _UART_H
+#define _UART_H
+
+#include "timers.h"
+
+/**
+ @Summary
+    Size of the receive ring buffer, a power of 2 up to 256
+ */
+#ifndef UART_RX_BUFFER
+#define UART_RX_BUFFER 256
+#endif
+
+/**
+@Function
+    unsigned char uart_init(const pin *tx, const pin *rx, unsigned long baud)
+
+@Summary
+    The function starts UART1 (8N1) on the given pins.
+
+@Description
+    TX and RX are routed through <code>pin_assign_peripheral</code>. The
+    receiver runs on the UART1 receive vector: every character is moved to a
+    ring buffer as soon as it arrives, so the 4-deep hardware FIFO does not
+    overflow while the main loop is busy. Transmission is polled.
+    The baud rate generator runs in high speed mode (BRGH = 1) from PB_FREQ.
+
+@Precondition
+    <code>interrupt_init</code> to have the receiver running.
+
+@Parameters
+    @param tx pin of the U1TX output (PPS group 1)
+    @param rx pin of the U1RX input (PPS group 3)
+    @param baud the bit rate
+
+@Returns
+<ul>
+    <li><code>1</code> if the UART has been started</li>
+    <li><code>0</code> if a pin cannot host its signal or the bit rate is out of
+        reach of PB_FREQ (error above 3%)</li>
+</ul>
+
+@Remarks
+    With the default PB_DIV of 8 (5 MHz), 115200 baud is 1.4% slow. Lower
+    FPBDIV and PB_DIV for faster links.
+
+@Example
+    @code
+    uart_init(&RB7, &RB13, 115200);
+*/
+extern unsigned char uart_init(const pin *tx, const pin *rx, unsigned long baud);
+
+/**
+@Function
+    unsigned int uart_read(unsigned char *data, unsigned int length)
+
+@Summary
+    The function moves up to <code>length</code> received bytes to
+    <code>data</code>, without waiting.
+
+@Returns
+    The number of bytes copied, 0 if nothing has been received.
+*/
+extern unsigned int uart_read(unsigned char *data, unsigned int length);
+
+/**
+@Function
+    void uart_write(const unsigned char *data, unsigned int length)
+
+@Summary
+    The function sends a buffer, waiting for room in the transmit FIFO.
+*/
+extern void uart_write(const unsigned char *data, unsigned int length);
+
+/**
+@Function
+    unsigned int uart_overruns(void)
+
+@Summary
+    The function returns how many times received data has been lost, either
+    by the hardware FIFO (OERR) or by a full ring buffer.
+*/
+extern unsigned int uart_overruns(void);
+
+#endif